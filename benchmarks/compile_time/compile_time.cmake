@@ -0,0 +1,179 @@
+#============================================================================
+#
+# Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+#
+# This file is part of the Path-to-Regex which can be found at
+# https://github.com/IvanPinezhaninov/path_to_regex/.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+# IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+# DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+# OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+# THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+#============================================================================
+
+# Compares the build cost of the library configurations on a program made of many
+# translation units, each compiling and matching its own pattern:
+#
+#   header-only  regex engine from <path_to_regex.hpp>, instantiated in every unit
+#   compiled     regex engine from the compiled library, built once
+#   native       native engine from <path_to_regex/native.hpp>
+#   module       `import path_to_regex;`, only with -DMODULE=ON (CMake 3.28, Ninja)
+#
+# Reports the median time to build the program on one core and its executable size.
+#
+# Usage: cmake -DCXX=... -DSOURCE_DIR=... -DBINARY_DIR=... [-DUNITS=16] [-DREPETITIONS=3] [-DMODULE=ON]
+#              -P compile_time.cmake
+
+cmake_minimum_required(VERSION 3.23)
+
+if(NOT UNITS)
+  set(UNITS 16)
+endif()
+
+if(NOT REPETITIONS)
+  set(REPETITIONS 3)
+endif()
+
+function(write_sources dir preamble function)
+  set(declarations)
+  set(calls)
+  foreach(i RANGE 1 ${UNITS})
+    file(WRITE ${dir}/unit_${i}.cpp
+      "${preamble}\n\n"
+      "bool unit_${i}(const char* path)\n{\n"
+      "  static const auto matcher = ${function}(\"/unit${i}/:id\");\n"
+      "  return matcher(path).matched;\n}\n"
+    )
+    string(APPEND declarations "bool unit_${i}(const char* path);\n")
+    string(APPEND calls "  matched += unit_${i}(argv[1]);\n")
+  endforeach()
+
+  file(WRITE ${dir}/main.cpp
+    "#include <cstdlib>\n\n${declarations}\n"
+    "int main(int argc, char** argv)\n{\n"
+    "  if (argc < 2) return EXIT_FAILURE;\n"
+    "  int matched = 0;\n${calls}"
+    "  return matched ? EXIT_SUCCESS : EXIT_FAILURE;\n}\n"
+  )
+endfunction()
+
+# Builds the module configuration through CMake, which has to scan the units for imports.
+function(write_module_project dir)
+  file(WRITE ${dir}/CMakeLists.txt
+    "cmake_minimum_required(VERSION 3.28)\n"
+    "project(path_to_regex_module_units LANGUAGES CXX)\n"
+    "set(PATH_TO_REGEX_BUILD_MODULE ON CACHE BOOL \"\" FORCE)\n"
+    "add_subdirectory(${SOURCE_DIR} path_to_regex)\n"
+    "file(GLOB sources *.cpp)\n"
+    "add_executable(program \${sources})\n"
+    "target_link_libraries(program PRIVATE path_to_regex::module)\n"
+    "set_target_properties(program PROPERTIES CXX_STANDARD 20 RUNTIME_OUTPUT_DIRECTORY ${dir})\n"
+  )
+
+  execute_process(
+    COMMAND ${CMAKE_COMMAND} -S ${dir} -B ${dir}/build -G Ninja -DCMAKE_CXX_COMPILER=${CXX}
+            -DCMAKE_BUILD_TYPE=Release -DCMAKE_CXX_FLAGS_RELEASE=-O2
+    OUTPUT_QUIET
+    RESULT_VARIABLE result
+  )
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Failed to configure ${dir}")
+  endif()
+endfunction()
+
+function(build_module dir elapsed_var)
+  string(TIMESTAMP start "%s%f")
+  execute_process(
+    COMMAND ${CMAKE_COMMAND} --build ${dir}/build --clean-first -j 1
+    OUTPUT_QUIET
+    RESULT_VARIABLE result
+  )
+  string(TIMESTAMP stop "%s%f")
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Failed to build ${dir}")
+  endif()
+
+  math(EXPR elapsed "(${stop} - ${start}) / 1000")
+  set(${elapsed_var} ${elapsed} PARENT_SCOPE)
+endfunction()
+
+function(build dir elapsed_var)
+  file(GLOB sources ${dir}/*.cpp)
+  list(APPEND sources ${ARGN})
+
+  string(TIMESTAMP start "%s%f")
+  set(objects)
+  foreach(source ${sources})
+    get_filename_component(name ${source} NAME_WE)
+    execute_process(
+      COMMAND ${CXX} -std=c++17 -O2 ${flags} -I${SOURCE_DIR}/include -c ${source} -o ${dir}/${name}.o
+      RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+      message(FATAL_ERROR "Failed to compile ${source}")
+    endif()
+    list(APPEND objects ${dir}/${name}.o)
+  endforeach()
+
+  execute_process(COMMAND ${CXX} ${objects} -o ${dir}/program RESULT_VARIABLE result)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Failed to link ${dir}/program")
+  endif()
+  string(TIMESTAMP stop "%s%f")
+
+  math(EXPR elapsed "(${stop} - ${start}) / 1000")
+  set(${elapsed_var} ${elapsed} PARENT_SCOPE)
+endfunction()
+
+message("${UNITS} translation units")
+message("configuration   median build time   executable size")
+
+set(configurations header-only compiled native)
+if(MODULE)
+  list(APPEND configurations module)
+endif()
+
+foreach(configuration ${configurations})
+  set(dir ${BINARY_DIR}/${configuration})
+  file(REMOVE_RECURSE ${dir})
+  file(MAKE_DIRECTORY ${dir})
+
+  set(flags)
+  set(library)
+  if(configuration STREQUAL "native")
+    write_sources(${dir} "#include <path_to_regex/native.hpp>" path_to_regex::native::match)
+  elseif(configuration STREQUAL "module")
+    write_sources(${dir} "import path_to_regex;" path_to_regex::match)
+    write_module_project(${dir})
+  else()
+    write_sources(${dir} "#include <path_to_regex.hpp>" path_to_regex::match)
+  endif()
+  if(configuration STREQUAL "compiled")
+    set(flags -DPATH_TO_REGEX_COMPILED)
+    set(library ${SOURCE_DIR}/src/path_to_regex.cpp)
+  endif()
+
+  set(times)
+  foreach(i RANGE 1 ${REPETITIONS})
+    if(configuration STREQUAL "module")
+      build_module(${dir} elapsed)
+    else()
+      build(${dir} elapsed ${library})
+    endif()
+    list(APPEND times ${elapsed})
+  endforeach()
+
+  list(SORT times COMPARE NATURAL)
+  math(EXPR middle "${REPETITIONS} / 2")
+  list(GET times ${middle} median)
+  file(SIZE ${dir}/program size)
+
+  string(LENGTH "${configuration}" length)
+  math(EXPR padding "16 - ${length}")
+  string(REPEAT " " ${padding} spaces)
+  message("${configuration}${spaces}${median} ms            ${size} bytes")
+endforeach()
@@ -0,0 +1,523 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_BENCHMARKS_HARNESS_H
+#define PATH_TO_REGEX_BENCHMARKS_HARNESS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+/**
+ * @brief Prevents the compiler from optimizing away the computation of a value.
+ */
+template<typename T>
+void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+/**
+ * @class perf_counters
+ * @brief Hardware performance counters of the process, read with Linux `perf_event_open`.
+ *
+ * Every counter is opened on its own, so counters the kernel refuses, as is common in
+ * containers and virtual machines, are left out without disabling the others.
+ * Threads started while counting are included once they have exited.
+ */
+class perf_counters {
+public:
+  struct counter {
+    const char* name;
+    uint32_t type;
+    uint64_t config;
+    int fd = -1;
+    double value = 0; ///< Count of the last start/stop interval, scaled if the counter was multiplexed.
+  };
+
+  perf_counters()
+  {
+#if defined(__linux__)
+    const counter all[] = {
+      {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+      {"l1d-misses", PERF_TYPE_HW_CACHE,
+       PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+      {"llc-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    };
+
+    for (auto c : all) {
+      perf_event_attr attr{};
+      attr.size = sizeof(attr);
+      attr.type = c.type;
+      attr.config = c.config;
+      attr.disabled = 1;
+      attr.inherit = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      c.fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+      if (c.fd >= 0) m_counters.push_back(c);
+    }
+#endif
+  }
+
+  perf_counters(const perf_counters&) = delete;
+  perf_counters& operator=(const perf_counters&) = delete;
+
+  ~perf_counters()
+  {
+#if defined(__linux__)
+    for (const auto& c : m_counters)
+      close(c.fd);
+#endif
+  }
+
+  /**
+   * @brief Returns whether at least one counter could be opened.
+   */
+  bool available() const
+  {
+    return !m_counters.empty();
+  }
+
+  /**
+   * @brief Resets and starts all counters.
+   */
+  void start()
+  {
+#if defined(__linux__)
+    for (const auto& c : m_counters) {
+      ioctl(c.fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(c.fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  /**
+   * @brief Stops all counters and reads their values.
+   */
+  void stop()
+  {
+#if defined(__linux__)
+    for (auto& c : m_counters) {
+      ioctl(c.fd, PERF_EVENT_IOC_DISABLE, 0);
+      uint64_t data[3] = {}; // value, time enabled, time running
+      c.value = 0;
+      if (read(c.fd, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) continue;
+      c.value = static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+    }
+#endif
+  }
+
+  /**
+   * @brief Returns the opened counters.
+   */
+  const std::vector<counter>& counters() const
+  {
+    return m_counters;
+  }
+
+private:
+  std::vector<counter> m_counters;
+};
+
+/**
+ * @class harness
+ * @brief Minimal benchmark runner.
+ *
+ * Every benchmark is calibrated to run for at least the minimum time per repetition,
+ * and the median time of several repetitions is reported per operation. With `--perf`
+ * the hardware counters over all repetitions are reported per operation as well.
+ *
+ * Latency benchmarks time every call on its own and report percentiles of the distribution,
+ * optionally with the CPU caches evicted before every call.
+ *
+ * The results can be written to a JSON file with `--json` and compared with a baseline
+ * written by an earlier run with `--baseline`, see `finish`.
+ */
+class harness {
+public:
+  harness(int argc, char** argv)
+  {
+    auto perf = false;
+    for (int i = 1; i < argc; ++i) {
+      std::string_view arg = argv[i];
+      if (arg == "--filter" && i + 1 < argc)
+        m_filter = argv[++i];
+      else if (arg == "--min-time" && i + 1 < argc)
+        m_min_time = std::chrono::milliseconds{std::strtoul(argv[++i], nullptr, 10)};
+      else if (arg == "--repetitions" && i + 1 < argc)
+        m_repetitions = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+      else if (arg == "--perf")
+        perf = true;
+      else if (arg == "--samples" && i + 1 < argc)
+        m_samples = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+      else if (arg == "--cold-size" && i + 1 < argc)
+        m_cold_size = std::max(1ul, std::strtoul(argv[++i], nullptr, 10)) << 20;
+      else if (arg == "--json" && i + 1 < argc)
+        m_json = argv[++i];
+      else if (arg == "--baseline" && i + 1 < argc)
+        m_baseline = argv[++i];
+      else if (arg == "--threshold" && i + 1 < argc)
+        m_threshold = std::strtod(argv[++i], nullptr);
+    }
+
+    if (perf) {
+      m_perf = std::make_unique<perf_counters>();
+      if (!m_perf->available()) {
+        std::fprintf(stderr, "Hardware performance counters are unavailable, reporting timings only\n");
+        m_perf.reset();
+      }
+    }
+  }
+
+  /**
+   * @brief Returns whether a benchmark passes the `--filter` substring.
+   */
+  bool enabled(std::string_view name) const
+  {
+    return name.find(m_filter) != std::string_view::npos;
+  }
+
+  /**
+   * @brief Runs a benchmark.
+   *
+   * @param name Benchmark name.
+   * @param ops Number of operations performed by one call of `f`.
+   * @param f Benchmark body.
+   * @return Median nanoseconds per operation, or zero if the benchmark is filtered out.
+   */
+  template<typename F>
+  double run(const std::string& name, size_t ops, F&& f)
+  {
+    if (!enabled(name)) return 0;
+
+    size_t iterations = 1;
+    for (;;) {
+      auto elapsed = time(iterations, f);
+      if (elapsed >= m_min_time / 10 || iterations >= (size_t{1} << 30)) {
+        auto scale = std::chrono::duration<double>(m_min_time) / std::max(elapsed, clock::duration{1});
+        iterations = std::max<size_t>(1, static_cast<size_t>(iterations * scale));
+        break;
+      }
+      iterations *= 10;
+    }
+
+    std::vector<double> samples;
+    if (m_perf) m_perf->start();
+    for (size_t i = 0; i < m_repetitions; ++i) {
+      auto elapsed = std::chrono::duration<double, std::nano>(time(iterations, f)).count();
+      samples.push_back(elapsed / static_cast<double>(iterations * ops));
+    }
+    if (m_perf) m_perf->stop();
+    std::sort(samples.begin(), samples.end());
+    auto ns = samples[samples.size() / 2];
+
+    std::printf("%-48s %12.1f ns/op %14.0f op/s", name.c_str(), ns, 1e9 / ns);
+    if (m_perf) print_counters(static_cast<double>(m_repetitions * iterations * ops));
+    std::printf("\n");
+    std::fflush(stdout);
+    m_results.push_back({name, ns, {}});
+    return ns;
+  }
+
+  /**
+   * @brief Runs a latency benchmark.
+   *
+   * Times `--samples` calls of `f` one by one, or a tenth of them when cold, and reports
+   * percentiles of the per-call latency. The cost of reading the clock is subtracted.
+   *
+   * @param name Benchmark name.
+   * @param f Benchmark body performing one operation.
+   * @param cold Evicts the CPU caches before every call by writing to a buffer of `--cold-size` MiB,
+   *             to measure e.g. the first request after a deploy or after other work.
+   */
+  template<typename F>
+  void latency(const std::string& name, F&& f, bool cold = false)
+  {
+    if (!enabled(name)) return;
+
+    auto samples_count = cold ? std::max<size_t>(1, m_samples / 10) : m_samples;
+    if (cold) m_cold_buffer.resize(m_cold_size);
+
+    auto overhead = clock::duration::max();
+    for (int i = 0; i < 1000; ++i) {
+      auto start = clock::now();
+      overhead = std::min(overhead, clock::now() - start);
+    }
+
+    std::vector<double> samples;
+    samples.reserve(samples_count);
+    for (size_t i = 0; i < samples_count; ++i) {
+      if (cold) evict_caches();
+      auto start = clock::now();
+      f();
+      auto elapsed = clock::now() - start - overhead;
+      samples.push_back(std::chrono::duration<double, std::nano>(std::max(elapsed, clock::duration::zero())).count());
+    }
+    std::sort(samples.begin(), samples.end());
+
+    auto percentile = [&](double p) {
+      return samples[std::min(samples.size() - 1, static_cast<size_t>(p * static_cast<double>(samples.size())))];
+    };
+    std::vector<double> percentiles{percentile(0.5), percentile(0.9), percentile(0.99), percentile(0.999),
+                                    samples.back()};
+    std::printf("%-48s p50 %9.1f  p90 %9.1f  p99 %9.1f  p99.9 %9.1f  max %9.1f ns\n", name.c_str(), percentiles[0],
+                percentiles[1], percentiles[2], percentiles[3], percentiles[4]);
+    std::fflush(stdout);
+    m_results.push_back({name, 0, std::move(percentiles)});
+  }
+
+  /**
+   * @brief Writes the `--json` file and compares the results with the `--baseline` file.
+   *
+   * Every benchmark run with `run` that is also in the baseline is compared by its time
+   * per operation, and is a regression if it is more than `--threshold` percent (10 by default)
+   * slower. Latency benchmarks are written but not compared, their tails are too noisy.
+   *
+   * Benchmarks of the baseline that did not run are reported as missing.
+   *
+   * @return `EXIT_FAILURE` if a benchmark regressed, a file cannot be read or written, or the
+   *         baseline has no benchmark in common with the run, `EXIT_SUCCESS` otherwise.
+   */
+  int finish() const
+  {
+    auto status = EXIT_SUCCESS;
+    if (!m_json.empty() && !write_json(m_json)) {
+      std::fprintf(stderr, "Cannot write %s\n", m_json.c_str());
+      status = EXIT_FAILURE;
+    }
+    if (!m_baseline.empty() && !compare(m_baseline)) status = EXIT_FAILURE;
+    return status;
+  }
+
+private:
+  using clock = std::chrono::steady_clock;
+
+  struct result {
+    std::string name;
+    double ns;                       ///< Time per operation, zero for latency benchmarks.
+    std::vector<double> percentiles; ///< p50, p90, p99, p99.9 and max latency of latency benchmarks.
+  };
+
+  static std::string quote(std::string_view text)
+  {
+    std::string quoted = "\"";
+    for (auto ch : text) {
+      if (ch == '"' || ch == '\\') quoted += '\\';
+      quoted += ch;
+    }
+    return quoted + "\"";
+  }
+
+  // Writes one benchmark per line.
+  bool write_json(const std::string& file) const
+  {
+    auto* out = std::fopen(file.c_str(), "w");
+    if (!out) return false;
+
+    std::fprintf(out, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < m_results.size(); ++i) {
+      const auto& r = m_results[i];
+      std::fprintf(out, "    {\"name\": %s, ", quote(r.name).c_str());
+      if (r.percentiles.empty()) {
+        // A time below the clock resolution has no finite rate, and JSON has no infinity.
+        std::fprintf(out, "\"ns_per_op\": %.3f", r.ns);
+        if (r.ns > 0) std::fprintf(out, ", \"ops_per_second\": %.1f", 1e9 / r.ns);
+        std::fprintf(out, "}");
+      } else {
+        std::fprintf(out, "\"p50_ns\": %.1f, \"p90_ns\": %.1f, \"p99_ns\": %.1f, \"p999_ns\": %.1f, \"max_ns\": %.1f}",
+                     r.percentiles[0], r.percentiles[1], r.percentiles[2], r.percentiles[3], r.percentiles[4]);
+      }
+      std::fprintf(out, "%s\n", i + 1 < m_results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+    return std::fclose(out) == 0;
+  }
+
+  // Reads the time per operation of the benchmarks of a file written by `write_json`.
+  // The layout is free, so that a reformatted file can be read: every object with a string
+  // "name" and a number "ns_per_op" is a benchmark. Returns false if the file cannot be read
+  // or its braces or strings are not closed.
+  static bool read_json(const std::string& file, std::vector<std::pair<std::string, double>>& baseline)
+  {
+    std::ifstream in{file};
+    if (!in) return false;
+    std::string text{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+
+    struct object {
+      std::string name;
+      double ns = -1;
+    };
+    std::vector<object> objects;
+    std::string key;
+
+    for (size_t i = 0; i < text.size(); ++i) {
+      auto ch = text[i];
+      if (ch == '{') {
+        objects.emplace_back();
+        key.clear();
+      } else if (ch == '}') {
+        if (objects.empty()) return false;
+        auto o = std::move(objects.back());
+        objects.pop_back();
+        if (!o.name.empty() && o.ns >= 0) baseline.emplace_back(std::move(o.name), o.ns);
+      } else if (ch == '"') {
+        std::string str;
+        for (++i; i < text.size() && text[i] != '"'; ++i) {
+          if (text[i] == '\\' && i + 1 < text.size()) ++i;
+          str += text[i];
+        }
+        if (i == text.size()) return false;
+
+        auto next = text.find_first_not_of(" \t\r\n", i + 1);
+        if (next != std::string::npos && text[next] == ':') {
+          key = std::move(str);
+          i = next;
+        } else if (key == "name" && !objects.empty()) {
+          objects.back().name = std::move(str);
+        }
+      } else if (ch == '-' || (ch >= '0' && ch <= '9')) {
+        char* end = nullptr;
+        auto value = std::strtod(text.c_str() + i, &end);
+        if (end == text.c_str() + i) continue;
+        if (key == "ns_per_op" && !objects.empty()) objects.back().ns = value;
+        i = static_cast<size_t>(end - text.c_str()) - 1;
+      }
+    }
+    return objects.empty();
+  }
+
+  bool compare(const std::string& file) const
+  {
+    std::vector<std::pair<std::string, double>> baseline;
+    if (!read_json(file, baseline)) {
+      std::fprintf(stderr, "Cannot read %s\n", file.c_str());
+      return false;
+    }
+    if (baseline.empty()) {
+      std::fprintf(stderr, "No benchmark with a \"name\" and \"ns_per_op\" in %s\n", file.c_str());
+      return false;
+    }
+
+    size_t regressions = 0;
+    size_t compared = 0;
+    std::printf("\n%-48s %12s %12s %9s\n", "benchmark", "baseline", "current", "change");
+    for (const auto& r : m_results) {
+      if (!r.percentiles.empty()) continue;
+      auto it = std::find_if(baseline.begin(), baseline.end(), [&](const auto& b) { return b.first == r.name; });
+      if (it == baseline.end() || it->second <= 0) {
+        std::printf("%-48s %12s %12.1f %9s\n", r.name.c_str(), "-", r.ns, "new");
+        continue;
+      }
+
+      auto change = (r.ns / it->second - 1.0) * 100.0;
+      auto regressed = change > m_threshold;
+      regressions += regressed;
+      ++compared;
+      std::printf("%-48s %12.1f %12.1f %+8.1f%%%s\n", r.name.c_str(), it->second, r.ns, change,
+                  regressed ? "  REGRESSION" : "");
+    }
+
+    // Benchmarks of the baseline that did not run, e.g. renamed, removed or filtered out.
+    size_t missing = 0;
+    for (const auto& [name, ns] : baseline) {
+      auto ran = std::any_of(m_results.begin(), m_results.end(), [&](const auto& r) { return r.name == name; });
+      if (ran) continue;
+      ++missing;
+      std::printf("%-48s %12.1f %12s %9s\n", name.c_str(), ns, "-", "missing");
+    }
+
+    std::printf("\n%zu regression(s) above %.1f%% against %s, %zu compared, %zu missing\n", regressions, m_threshold,
+                file.c_str(), compared, missing);
+    if (compared == 0) {
+      std::fprintf(stderr, "No benchmark in common with %s\n", file.c_str());
+      return false;
+    }
+    return regressions == 0;
+  }
+
+  // Writes to every cache line of a buffer larger than the last-level cache.
+  void evict_caches()
+  {
+    constexpr size_t cache_line = 64;
+    for (size_t i = 0; i < m_cold_buffer.size(); i += cache_line)
+      ++m_cold_buffer[i];
+    do_not_optimize(m_cold_buffer.data());
+  }
+
+  void print_counters(double ops) const
+  {
+    double cycles = 0;
+    double instructions = 0;
+    for (const auto& c : m_perf->counters()) {
+      std::printf(" %10.1f %s", c.value / ops, c.name);
+      if (std::string_view{c.name} == "cycles") cycles = c.value;
+      if (std::string_view{c.name} == "instructions") instructions = c.value;
+    }
+    if (cycles != 0 && instructions != 0) std::printf(" %6.2f IPC", instructions / cycles);
+  }
+
+  template<typename F>
+  static clock::duration time(size_t iterations, F& f)
+  {
+    auto start = clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+      f();
+    return clock::now() - start;
+  }
+
+  std::string m_filter;
+  std::chrono::milliseconds m_min_time{200};
+  size_t m_repetitions = 5;
+  std::unique_ptr<perf_counters> m_perf;
+  size_t m_samples = 10000;
+  size_t m_cold_size = size_t{64} << 20;
+  std::vector<char> m_cold_buffer;
+  std::string m_json;
+  std::string m_baseline;
+  double m_threshold = 10.0;
+  std::vector<result> m_results;
+};
+
+} // namespace bench
+
+#endif // PATH_TO_REGEX_BENCHMARKS_HARNESS_H
@@ -0,0 +1,446 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <path_to_regex.hpp>
+#include <path_to_regex/batch.hpp>
+#include <path_to_regex/chain.hpp>
+#include <path_to_regex/native.hpp>
+#include <path_to_regex/router.hpp>
+
+#include "corpus.hpp"
+#include "harness.hpp"
+
+namespace {
+
+using params_type = std::unordered_map<std::string, std::string>;
+
+// Aborts the run if a benchmarked engine returns a wrong result for its input.
+void verify(bool ok, const std::string& what)
+{
+  if (ok) return;
+  std::fprintf(stderr, "Wrong result: %s\n", what.c_str());
+  std::exit(EXIT_FAILURE);
+}
+
+void verify(const std::string& engine, const corpus::test_case& test, bool matched, const params_type& params)
+{
+  verify(matched == test.matched && params == test.params,
+         engine + " on pattern \"" + test.pattern + "\" and path \"" + test.path + "\"");
+}
+
+// Returns the corpus case of a benchmark input, so that every input is one the tests verify.
+const corpus::test_case& find_case(std::string_view pattern, std::string_view path)
+{
+  const auto& cases = corpus::load_all();
+  auto it = std::find_if(cases.begin(), cases.end(), [&](const corpus::test_case& test) {
+    return test.pattern == pattern && test.path == path &&
+           test.sensitivity == path_to_regex::case_sensitivity::case_sensitive;
+  });
+  verify(it != cases.end(), "no corpus case for pattern \"" + std::string{pattern} + "\" and path \"" +
+                                std::string{path} + "\"");
+  return *it;
+}
+
+void bench_match(bench::harness& h)
+{
+  struct test_case {
+    const char* name;
+    const char* pattern;
+    const char* path;
+  };
+
+  const test_case cases[] = {
+    {"match/static", "/api/v1/status", "/api/v1/status"},
+    {"match/param", "/users/:id", "/users/12345"},
+    {"match/optional", "/download/:file{.:ext}", "/download/archive.zip"},
+    {"match/wildcard", "/static/*path", "/static/css/site/main.css"},
+    {"match/miss", "/users/:id/posts", "/users/12345/comments"},
+  };
+
+  for (const auto& c : cases) {
+    auto matcher = path_to_regex::match(c.pattern);
+    auto res = matcher(c.path);
+    verify(c.name, find_case(c.pattern, c.path), res.matched, res.params);
+    h.run(c.name, 1, [&] { bench::do_not_optimize(matcher(c.path)); });
+  }
+}
+
+// Matches every case of the test corpus with each engine. The results of every engine
+// are verified against the corpus before it is timed.
+void bench_corpus(bench::harness& h)
+{
+  const auto& cases = corpus::load_all();
+
+  std::vector<path_to_regex::matcher> matchers;
+  for (const auto& test : cases) {
+    matchers.push_back(path_to_regex::match(test.pattern, test.sensitivity));
+    auto res = matchers.back()(test.path);
+    verify("regex", test, res.matched, res.params);
+  }
+  h.run("corpus/regex", cases.size(), [&] {
+    for (size_t i = 0; i < cases.size(); ++i)
+      bench::do_not_optimize(matchers[i](cases[i].path));
+  });
+
+  path_to_regex::matcher::result result;
+  for (size_t i = 0; i < cases.size(); ++i) {
+    verify(matchers[i].try_match(cases[i].path, result) == path_to_regex::match_status::ok, "try_match aborted");
+    verify("try_match", cases[i], result.matched, result.params);
+  }
+  h.run("corpus/try_match", cases.size(), [&] {
+    for (size_t i = 0; i < cases.size(); ++i)
+      bench::do_not_optimize(matchers[i].try_match(cases[i].path, result));
+  });
+
+  // Custom subpatterns are not supported by the native engine, those cases are left out.
+  std::vector<std::pair<path_to_regex::native::matcher, const corpus::test_case*>> natives;
+  for (const auto& test : cases) {
+    try {
+      natives.emplace_back(path_to_regex::native::match(test.pattern, test.sensitivity), &test);
+    } catch (const std::invalid_argument&) {
+      continue;
+    }
+    auto res = natives.back().first(test.path);
+    verify("native", test, res.matched, res.params);
+  }
+  h.run("corpus/native", natives.size(), [&] {
+    for (const auto& [matcher, test] : natives)
+      bench::do_not_optimize(matcher(test->path));
+  });
+
+  std::vector<path_to_regex::router> routers;
+  for (const auto& test : cases) {
+    routers.emplace_back(std::vector<path_to_regex::route>{{test.pattern, 1, test.sensitivity}});
+    auto res = routers.back()(test.path);
+    verify("router", test, res.matched, res.params);
+  }
+  h.run("corpus/router", cases.size(), [&] {
+    for (size_t i = 0; i < cases.size(); ++i)
+      bench::do_not_optimize(routers[i](cases[i].path));
+  });
+
+  std::vector<path_to_regex::chain_resolver> chains;
+  std::vector<path_to_regex::chain_resolver::match> matches;
+  for (const auto& test : cases) {
+    path_to_regex::chain_entry entry{test.pattern, 1, path_to_regex::match_mode::full, test.sensitivity};
+    chains.emplace_back(std::vector<path_to_regex::chain_entry>{entry});
+    chains.back()(test.path, matches);
+    verify("chain_resolver", test, !matches.empty(), matches.empty() ? params_type{} : matches.front().params);
+  }
+  h.run("corpus/chain", cases.size(), [&] {
+    for (size_t i = 0; i < cases.size(); ++i) {
+      chains[i](cases[i].path, matches);
+      bench::do_not_optimize(matches);
+    }
+  });
+
+  // The batch matcher gets the paths of consecutive cases with the same pattern as one batch.
+  struct group {
+    size_t first;
+    size_t matcher;
+    std::vector<std::string_view> paths;
+  };
+  std::vector<group> groups;
+  for (size_t i = 0; i < cases.size(); ++i) {
+    if (groups.empty() || cases[i].pattern != cases[i - 1].pattern || cases[i].sensitivity != cases[i - 1].sensitivity)
+      groups.push_back({i, i, {}});
+    groups.back().paths.push_back(cases[i].path);
+  }
+  std::vector<path_to_regex::batch_matcher<>> batches;
+  std::vector<path_to_regex::matcher::result> results;
+  for (const auto& g : groups) {
+    batches.emplace_back(matchers[g.matcher]);
+    batches.back()(g.paths, results);
+    for (size_t i = 0; i < results.size(); ++i)
+      verify("batch_matcher", cases[g.first + i], results[i].matched, results[i].params);
+  }
+  h.run("corpus/batch", cases.size(), [&] {
+    for (size_t i = 0; i < groups.size(); ++i) {
+      batches[i](groups[i].paths, results);
+      bench::do_not_optimize(results);
+    }
+  });
+}
+
+// Reports the latency distribution of single matches, with warm caches as in a steady stream
+// of requests and with cold caches as for the first requests after a deploy.
+void bench_latency(bench::harness& h)
+{
+  constexpr size_t routes_count = 1000;
+  const char* pattern = "/users/:id";
+  const char* path = "/users/12345";
+  const auto& expected = find_case(pattern, path);
+
+  auto matcher = path_to_regex::match(pattern);
+  auto res = matcher(path);
+  verify("latency/matcher", expected, res.matched, res.params);
+
+  auto native = path_to_regex::native::match(pattern);
+  auto native_res = native(path);
+  verify("latency/native", expected, native_res.matched, native_res.params);
+
+  // The route of the path is the last one, so that every route is tried.
+  std::vector<std::string> patterns;
+  std::vector<path_to_regex::route> routes;
+  for (size_t i = 0; i + 1 < routes_count; ++i)
+    patterns.push_back("/api/r" + std::to_string(i) + (i % 2 ? "/:id" : "/items"));
+  patterns.push_back(pattern);
+  for (size_t i = 0; i < routes_count; ++i)
+    routes.push_back({patterns[i], i});
+  path_to_regex::router router{routes};
+  auto routed = router(path);
+  verify("latency/router", expected, routed.matched && routed.id == routes_count - 1, routed.params);
+
+  for (auto cold : {false, true}) {
+    std::string suffix = cold ? "/cold" : "/warm";
+    h.latency("latency/matcher" + suffix, [&] { bench::do_not_optimize(matcher(path)); }, cold);
+    h.latency("latency/native" + suffix, [&] { bench::do_not_optimize(native(path)); }, cold);
+    h.latency("latency/router" + suffix, [&] { bench::do_not_optimize(router(path)); }, cold);
+  }
+}
+
+// Compares matching every path against the deduplicating batch matcher
+// on batches with an increasing share of repeated paths.
+void bench_batch_dedup(bench::harness& h)
+{
+  constexpr size_t batch_size = 4096;
+  const double ratios[] = {0.0, 0.5, 0.9, 0.99, 0.999};
+
+  auto matcher = path_to_regex::match("/tenants/:tenant/users/:id");
+  path_to_regex::batch_matcher dedup{matcher, batch_size};
+  path_to_regex::batch_matcher direct{matcher, 0};
+  std::vector<path_to_regex::matcher::result> results;
+
+  std::vector<std::pair<double, double>> speedups;
+  for (auto ratio : ratios) {
+    auto distinct = std::max<size_t>(1, static_cast<size_t>(batch_size * (1.0 - ratio)));
+    std::vector<std::string> storage;
+    for (size_t i = 0; i < distinct; ++i)
+      storage.push_back("/tenants/t" + std::to_string(i % 97) + "/users/" + std::to_string(i));
+
+    std::vector<std::string_view> paths;
+    for (size_t i = 0; i < batch_size; ++i)
+      paths.push_back(storage[(i * 2654435761u) % distinct]);
+
+    std::vector<path_to_regex::matcher::result> expected;
+    direct(paths, expected);
+    dedup(paths, results);
+    for (size_t i = 0; i < paths.size(); ++i)
+      verify(results[i].matched == expected[i].matched && results[i].params == expected[i].params,
+             "batch/dedup on path \"" + std::string{paths[i]} + "\"");
+
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), "/dup:%.3f", ratio);
+    auto direct_ns = h.run(std::string{"batch/direct"} + suffix, batch_size, [&] {
+      direct(paths, results);
+      bench::do_not_optimize(results);
+    });
+    auto dedup_ns = h.run(std::string{"batch/dedup"} + suffix, batch_size, [&] {
+      dedup(paths, results);
+      bench::do_not_optimize(results);
+    });
+    if (direct_ns != 0 && dedup_ns != 0) speedups.emplace_back(ratio, direct_ns / dedup_ns);
+  }
+
+  if (speedups.empty()) return;
+
+  std::printf("\n%-16s %s\n", "duplicates", "dedup speedup");
+  for (const auto& [ratio, speedup] : speedups)
+    std::printf("%-16.3f %.2fx\n", ratio, speedup);
+  std::printf("\n");
+}
+
+// Routes a skewed path stream, where 1% of the routes receive 90% of the traffic,
+// before and after optimizing the router for the recorded profile.
+void bench_router_profile(bench::harness& h)
+{
+  constexpr size_t routes_count = 1000;
+  constexpr size_t paths_count = 1000;
+
+  std::vector<std::string> patterns;
+  std::vector<path_to_regex::route> routes;
+  for (size_t i = 0; i < routes_count; ++i)
+    patterns.push_back("/api/r" + std::to_string(i) + (i % 2 ? "/:id" : "/items"));
+  for (size_t i = 0; i < routes_count; ++i)
+    routes.push_back({patterns[i], i});
+
+  std::vector<std::string> paths;
+  for (size_t i = 0; i < paths_count; ++i) {
+    auto route = (i % 10 != 0) ? routes_count - 1 - (i % (routes_count / 100)) : (i * 7919) % routes_count;
+    paths.push_back("/api/r" + std::to_string(route) + (route % 2 ? "/42" : "/items"));
+  }
+
+  path_to_regex::router router{routes};
+  std::vector<path_to_regex::router::result> expected;
+  for (const auto& path : paths)
+    expected.push_back(router(path));
+  auto verify_all = [&](const char* name) {
+    for (size_t i = 0; i < paths.size(); ++i) {
+      auto res = router(paths[i]);
+      verify(res.matched == expected[i].matched && res.id == expected[i].id && res.params == expected[i].params,
+             std::string{name} + " on path \"" + paths[i] + "\"");
+    }
+  };
+
+  verify_all("router/profile/unoptimized");
+  auto route_all = [&] {
+    for (const auto& path : paths)
+      bench::do_not_optimize(router(path));
+  };
+
+  h.run("router/profile/unoptimized", paths_count, route_all);
+
+  path_to_regex::route_profile profile;
+  for (const auto& path : paths)
+    router(path, profile);
+  router.optimize(profile);
+  verify_all("router/profile/optimized");
+
+  h.run("router/profile/optimized", paths_count, route_all);
+}
+
+// Resolves a request through 40 prefix-mounted middlewares and a final route,
+// once with a matcher per entry and once with the chain resolver.
+void bench_chain(bench::harness& h)
+{
+  constexpr size_t middlewares_count = 40;
+
+  std::vector<std::string> patterns;
+  for (size_t i = 0; i < middlewares_count; ++i)
+    patterns.push_back(i % 4 == 0 ? "/" : "/api/m" + std::to_string(i) + (i % 3 ? "" : "/:tenant"));
+  patterns.push_back("/api/m7/users/:id");
+
+  std::vector<path_to_regex::chain_entry> entries;
+  std::vector<path_to_regex::matcher> matchers;
+  for (size_t i = 0; i < patterns.size(); ++i) {
+    auto mode = i < middlewares_count ? path_to_regex::match_mode::prefix : path_to_regex::match_mode::full;
+    entries.push_back({patterns[i], i, mode});
+    matchers.push_back(mode == path_to_regex::match_mode::prefix ? path_to_regex::match_prefix(patterns[i])
+                                                                 : path_to_regex::match(patterns[i]));
+  }
+
+  const char* path = "/api/m7/users/42";
+  h.run("chain/matchers", 1, [&] {
+    for (const auto& matcher : matchers)
+      bench::do_not_optimize(matcher(path));
+  });
+
+  path_to_regex::chain_resolver chain{entries};
+  std::vector<path_to_regex::chain_resolver::match> matches;
+  chain(path, matches);
+  std::vector<size_t> expected;
+  for (size_t i = 0; i < matchers.size(); ++i)
+    if (matchers[i](path).matched) expected.push_back(i);
+  verify(matches.size() == expected.size(), "chain/resolver match count");
+  for (size_t i = 0; i < matches.size(); ++i)
+    verify(matches[i].id == expected[i] && matches[i].params == matchers[expected[i]](path).params,
+           "chain/resolver match " + std::to_string(i));
+  h.run("chain/resolver", 1, [&] {
+    chain(path, matches);
+    bench::do_not_optimize(matches);
+  });
+}
+
+// Measures the throughput of matching with one shared matcher and of compiling patterns
+// concurrently from 1 thread up to the number of hardware threads. An efficiency well below
+// 100% with idle cores points at false sharing or a hidden global lock.
+void bench_scaling(bench::harness& h)
+{
+  constexpr size_t ops_per_thread = 256;
+
+  auto hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<size_t> threads_counts;
+  for (size_t threads = 1; threads < hardware_threads; threads *= 2)
+    threads_counts.push_back(threads);
+  threads_counts.push_back(hardware_threads);
+
+  auto run_threads = [](size_t threads, auto&& f) {
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t)
+      workers.emplace_back([&f, t] { f(t); });
+    for (auto& worker : workers)
+      worker.join();
+  };
+
+  const auto matcher = path_to_regex::match("/tenants/:tenant/users/:id");
+  std::vector<std::string> paths;
+  for (size_t i = 0; i < ops_per_thread; ++i)
+    paths.push_back("/tenants/t" + std::to_string(i % 16) + "/users/" + std::to_string(i));
+
+  struct row {
+    const char* name;
+    size_t threads;
+    double ns;
+  };
+  std::vector<row> rows;
+
+  for (auto threads : threads_counts) {
+    auto ns = h.run("scaling/match/threads:" + std::to_string(threads), threads * ops_per_thread, [&] {
+      run_threads(threads, [&](size_t) {
+        for (const auto& path : paths)
+          bench::do_not_optimize(matcher(path));
+      });
+    });
+    if (ns != 0) rows.push_back({"match", threads, ns});
+  }
+
+  for (auto threads : threads_counts) {
+    auto ns = h.run("scaling/compile/threads:" + std::to_string(threads), threads * ops_per_thread / 16, [&] {
+      run_threads(threads, [&](size_t t) {
+        for (size_t i = 0; i < ops_per_thread / 16; ++i)
+          bench::do_not_optimize(path_to_regex::match("/t" + std::to_string(t) + "/:id/" + std::to_string(i)));
+      });
+    });
+    if (ns != 0) rows.push_back({"compile", threads, ns});
+  }
+
+  if (rows.empty()) return;
+
+  std::printf("\n%-10s %-8s %14s %12s\n", "operation", "threads", "op/s", "efficiency");
+  for (const auto& r : rows) {
+    auto single = std::find_if(rows.begin(), rows.end(), [&](const row& other) {
+      return std::string_view{other.name} == r.name && other.threads == 1;
+    });
+    auto efficiency = single == rows.end() ? 0.0 : single->ns / (r.ns * static_cast<double>(r.threads));
+    std::printf("%-10s %-8zu %14.0f %11.0f%%\n", r.name, r.threads, 1e9 / r.ns, efficiency * 100.0);
+  }
+  std::printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  bench::harness h{argc, argv};
+
+  bench_match(h);
+  bench_corpus(h);
+  bench_latency(h);
+  bench_batch_dedup(h);
+  bench_router_profile(h);
+  bench_chain(h);
+  bench_scaling(h);
+
+  return h.finish();
+}
@@ -0,0 +1,67 @@
+#============================================================================
+#
+# Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+#
+# This file is part of the Path-to-Regex which can be found at
+# https://github.com/IvanPinezhaninov/path_to_regex/.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+# IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+# DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+# OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+# THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+#============================================================================
+
+#[=======================================================================[.rst:
+path_to_regex_generate_router
+-----------------------------
+
+Generates a C++ function matching paths against the routes of a route file
+and adds it to a target::
+
+  path_to_regex_generate_router(
+    TARGET <target>
+    ROUTES <route file>
+    NAME <name>
+    [NAMESPACE <namespace>]
+    [FUNCTION <function>]
+  )
+
+``<name>.hpp`` and ``<name>.cpp`` are generated in the current binary
+directory, which is added to the include directories of ``<target>``.
+The header declares ``path_to_regex::router::result <namespace>::<function>(std::string_view)``,
+which defaults to ``routes::match``.
+#]=======================================================================]
+
+function(path_to_regex_generate_router)
+  cmake_parse_arguments(ARG "" "TARGET;ROUTES;NAME;NAMESPACE;FUNCTION" "" ${ARGN})
+
+  if(NOT ARG_TARGET OR NOT ARG_ROUTES OR NOT ARG_NAME)
+    message(FATAL_ERROR "path_to_regex_generate_router requires TARGET, ROUTES and NAME")
+  endif()
+
+  if(NOT ARG_NAMESPACE)
+    set(ARG_NAMESPACE routes)
+  endif()
+
+  if(NOT ARG_FUNCTION)
+    set(ARG_FUNCTION match)
+  endif()
+
+  get_filename_component(routes "${ARG_ROUTES}" ABSOLUTE)
+  set(output "${CMAKE_CURRENT_BINARY_DIR}/${ARG_NAME}")
+
+  add_custom_command(
+    OUTPUT "${output}.hpp" "${output}.cpp"
+    COMMAND path_to_regex_generate -n ${ARG_NAMESPACE} -f ${ARG_FUNCTION} "${routes}" "${output}"
+    DEPENDS path_to_regex_generate "${routes}"
+    COMMENT "Generating router ${ARG_NAME} from ${ARG_ROUTES}"
+    VERBATIM
+  )
+
+  target_sources(${ARG_TARGET} PRIVATE "${output}.hpp" "${output}.cpp")
+  target_include_directories(${ARG_TARGET} PRIVATE "${CMAKE_CURRENT_BINARY_DIR}")
+endfunction()
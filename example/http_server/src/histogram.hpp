@@ -0,0 +1,141 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_HTTP_HISTOGRAM_H
+#define PATH_TO_REGEX_HTTP_HISTOGRAM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @class histogram
+ * @brief Log-linear latency histogram.
+ *
+ * Values are counted in 16 linear sub-buckets per power of two, so every value is known within
+ * about 6% in a fixed amount of memory whatever the number of samples. Histograms of several
+ * threads are merged before reporting.
+ */
+class histogram {
+public:
+  histogram()
+    : m_counts(64 << sub_bits)
+  {}
+
+  void add(uint64_t value)
+  {
+    ++m_counts[index(value)];
+    ++m_count;
+    m_max = std::max(m_max, value);
+  }
+
+  void merge(const histogram& other)
+  {
+    for (size_t i = 0; i < m_counts.size(); ++i)
+      m_counts[i] += other.m_counts[i];
+    m_count += other.m_count;
+    m_max = std::max(m_max, other.m_max);
+  }
+
+  uint64_t count() const
+  {
+    return m_count;
+  }
+
+  uint64_t max() const
+  {
+    return m_max;
+  }
+
+  /**
+   * @brief Returns the upper bound of the bucket holding the `p` quantile, `p` in [0, 1].
+   */
+  uint64_t percentile(double p) const
+  {
+    auto rank = static_cast<uint64_t>(p * static_cast<double>(m_count));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < m_counts.size(); ++i) {
+      seen += m_counts[i];
+      if (seen > rank) return std::min(lower_bound(i + 1) - 1, m_max);
+    }
+    return m_max;
+  }
+
+  /**
+   * @brief Prints one row per power of two of the non-empty range, with values scaled by `scale`.
+   */
+  void print(std::FILE* out, double scale, const char* unit) const
+  {
+    size_t first = 64;
+    size_t last = 0;
+    std::vector<uint64_t> rows(64);
+    for (size_t i = 0; i < m_counts.size(); ++i) {
+      if (m_counts[i] == 0) continue;
+      auto row = static_cast<size_t>(msb(lower_bound(i)));
+      rows[row] += m_counts[i];
+      first = std::min(first, row);
+      last = std::max(last, row);
+    }
+    if (first > last) return;
+
+    auto peak = *std::max_element(rows.begin(), rows.end());
+    uint64_t cumulative = 0;
+    for (auto row = first; row <= last; ++row) {
+      cumulative += rows[row];
+      auto low = static_cast<double>(row == 0 ? 0 : uint64_t{1} << row) / scale;
+      auto high = static_cast<double>(uint64_t{2} << row) / scale;
+      auto bar = static_cast<size_t>(40.0 * static_cast<double>(rows[row]) / static_cast<double>(peak));
+      std::fprintf(out, "  %10.1f - %-10.1f %s %10llu %6.2f%% %7.3f%%  %s\n", low, high, unit,
+                   static_cast<unsigned long long>(rows[row]), 100.0 * rows[row] / m_count,
+                   100.0 * cumulative / m_count, std::string(bar, '#').c_str());
+    }
+  }
+
+private:
+  static constexpr int sub_bits = 4;
+  static constexpr uint64_t sub_count = uint64_t{1} << sub_bits;
+
+  static int msb(uint64_t value)
+  {
+    int bit = 0;
+    while (value >>= 1)
+      ++bit;
+    return bit;
+  }
+
+  static size_t index(uint64_t value)
+  {
+    if (value < sub_count) return static_cast<size_t>(value);
+    auto shift = msb(value) - sub_bits;
+    return (static_cast<size_t>(shift + 1) << sub_bits) + static_cast<size_t>((value >> shift) & (sub_count - 1));
+  }
+
+  static uint64_t lower_bound(size_t index)
+  {
+    if (index < sub_count) return index;
+    auto shift = static_cast<int>(index >> sub_bits) - 1;
+    return (sub_count + (index & (sub_count - 1))) << shift;
+  }
+
+  std::vector<uint64_t> m_counts;
+  uint64_t m_count = 0;
+  uint64_t m_max = 0;
+};
+
+#endif // PATH_TO_REGEX_HTTP_HISTOGRAM_H
@@ -0,0 +1,426 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "histogram.hpp"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t read_size = 64 << 10;
+constexpr int max_events = 256;
+
+struct options {
+  std::string address = "127.0.0.1";
+  uint16_t port = 8080;
+  size_t connections = 16;
+  size_t threads = 1;
+  size_t pipeline = 1;
+  size_t duration = 10;
+  bool print_histogram = false;
+  std::vector<std::string> paths;
+};
+
+struct thread_stats {
+  uint64_t ok = 0;
+  uint64_t not_found = 0;
+  uint64_t other = 0;
+  uint64_t errors = 0;
+  histogram latency_ns;
+};
+
+// A persistent connection keeping up to `pipeline` requests in flight.
+struct connection {
+  int fd = -1;
+  size_t next_path = 0;
+  std::string in;
+  std::string out;
+  size_t written = 0;
+  std::vector<clock_type::time_point> sent; ///< Ring of the send times of the requests in flight.
+  size_t oldest = 0;
+  size_t in_flight = 0;
+};
+
+[[noreturn]] void fail(const std::string& what)
+{
+  throw std::runtime_error{what + ": " + std::strerror(errno)};
+}
+
+int connect_socket(const options& opts)
+{
+  auto fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) fail("socket");
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(opts.port);
+  if (::inet_pton(AF_INET, opts.address.c_str(), &addr.sin_addr) != 1)
+    throw std::runtime_error{"invalid address '" + opts.address + "'"};
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    ::close(fd);
+    fail("connect");
+  }
+
+  int one = 1;
+  ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  auto flags = ::fcntl(fd, F_GETFL, 0);
+  ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+  return fd;
+}
+
+// Extracts the request path from a line of a path list or of an access log:
+// a line starting with a path, or the target of a quoted `"METHOD /path HTTP/1.1"` request line.
+std::string_view extract_path(std::string_view line)
+{
+  auto start = line.front() == '/' ? 0 : line.find(" /");
+  if (start == std::string_view::npos) return {};
+  if (line[start] == ' ') ++start;
+
+  auto end = start;
+  while (end < line.size() && static_cast<unsigned char>(line[end]) > ' ' && line[end] != '"')
+    ++end;
+  return line.substr(start, end - start);
+}
+
+std::vector<std::string> read_paths(const std::string& file)
+{
+  std::ifstream in{file};
+  if (!in) throw std::runtime_error{"cannot open '" + file + "'"};
+
+  std::vector<std::string> paths;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line.front() == '#') continue;
+    auto path = extract_path(line);
+    if (!path.empty()) paths.emplace_back(path);
+  }
+  return paths;
+}
+
+bool equals_ignoring_case(std::string_view lhs, std::string_view rhs)
+{
+  return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](char l, char r) {
+           return std::tolower(static_cast<unsigned char>(l)) == std::tolower(static_cast<unsigned char>(r));
+         });
+}
+
+// Finds the body length in the header fields of a response head, without the status line.
+// Returns false if the length is invalid or the body is not delimited by Content-Length.
+bool parse_content_length(std::string_view fields, size_t& content_length)
+{
+  content_length = 0;
+  while (!fields.empty()) {
+    auto line_end = fields.find("\r\n");
+    auto line = fields.substr(0, line_end);
+    fields = line_end == std::string_view::npos ? std::string_view{} : fields.substr(line_end + 2);
+
+    auto colon = line.find(':');
+    if (colon == std::string_view::npos) continue;
+    auto name = line.substr(0, colon);
+    auto value = line.substr(colon + 1);
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+      value.remove_prefix(1);
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t'))
+      value.remove_suffix(1);
+
+    // Bodies delimited by a transfer coding, such as chunked, are not supported.
+    if (equals_ignoring_case(name, "Transfer-Encoding")) return false;
+    if (equals_ignoring_case(name, "Content-Length")) {
+      auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), content_length);
+      if (ec != std::errc{} || end != value.data() + value.size()) return false;
+    }
+  }
+  return true;
+}
+
+// Reads the complete responses of a connection. Returns false if the connection failed
+// or a response could not be delimited.
+bool read_responses(connection& c, std::vector<char>& buffer, thread_stats& stats)
+{
+  for (;;) {
+    auto n = ::recv(c.fd, buffer.data(), buffer.size(), 0);
+    if (n > 0) {
+      c.in.append(buffer.data(), static_cast<size_t>(n));
+      continue;
+    }
+    if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) return false;
+    break;
+  }
+
+  auto now = clock_type::now();
+  size_t pos = 0;
+  for (;;) {
+    auto head_end = c.in.find("\r\n\r\n", pos);
+    if (head_end == std::string::npos) break;
+
+    std::string_view head{c.in.data() + pos, head_end - pos};
+    auto status_end = head.find("\r\n");
+    auto fields = status_end == std::string_view::npos ? std::string_view{} : head.substr(status_end + 2);
+    size_t content_length = 0;
+    if (!parse_content_length(fields, content_length)) return false;
+    if (content_length > c.in.size() - head_end - 4) break;
+    auto response_end = head_end + 4 + content_length;
+
+    if (c.in_flight == 0) return false; // A response without a request.
+    auto elapsed = now - c.sent[c.oldest];
+    c.oldest = (c.oldest + 1) % c.sent.size();
+    --c.in_flight;
+    stats.latency_ns.add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+
+    auto status = response_end - pos > 12 ? std::atoi(c.in.c_str() + pos + 9) : 0;
+    if (status == 200)
+      ++stats.ok;
+    else if (status == 404)
+      ++stats.not_found;
+    else
+      ++stats.other;
+    pos = response_end;
+  }
+
+  c.in.erase(0, pos);
+  return true;
+}
+
+// Tops the requests in flight up to the pipeline depth and writes what the socket takes.
+// Returns false if the connection failed.
+bool send_requests(const options& opts, connection& c, bool sending)
+{
+  while (sending && c.in_flight < c.sent.size()) {
+    const auto& path = opts.paths[c.next_path];
+    c.next_path = (c.next_path + 1) % opts.paths.size();
+    c.out += "GET ";
+    c.out += path;
+    c.out += " HTTP/1.1\r\nHost: ";
+    c.out += opts.address;
+    c.out += "\r\n\r\n";
+    c.sent[(c.oldest + c.in_flight++) % c.sent.size()] = clock_type::now();
+  }
+
+  while (c.written < c.out.size()) {
+    auto n = ::send(c.fd, c.out.data() + c.written, c.out.size() - c.written, MSG_NOSIGNAL);
+    if (n < 0) return errno == EAGAIN || errno == EWOULDBLOCK;
+    c.written += static_cast<size_t>(n);
+  }
+  c.out.clear();
+  c.written = 0;
+  return true;
+}
+
+// Drives the connections of one thread until the deadline, then waits for the requests in flight.
+void run_thread(const options& opts, size_t first, size_t count, clock_type::time_point deadline, thread_stats& stats)
+{
+  auto epoll = ::epoll_create1(EPOLL_CLOEXEC);
+  if (epoll < 0) fail("epoll_create1");
+
+  std::vector<connection> connections(count);
+  for (size_t i = 0; i < count; ++i) {
+    auto& c = connections[i];
+    c.fd = connect_socket(opts);
+    c.sent.resize(opts.pipeline);
+    c.next_path = (first + i) * 7919 % opts.paths.size();
+
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLOUT;
+    ev.data.u64 = i;
+    ::epoll_ctl(epoll, EPOLL_CTL_ADD, c.fd, &ev);
+  }
+
+  std::vector<char> buffer(read_size);
+  epoll_event events[max_events];
+  auto open = count;
+  auto drain_deadline = deadline + std::chrono::seconds{2};
+
+  auto close_connection = [&](connection& c) {
+    ::close(c.fd);
+    c.fd = -1;
+    --open;
+  };
+
+  while (open != 0) {
+    auto now = clock_type::now();
+    if (now >= drain_deadline) break;
+    auto sending = now < deadline;
+
+    // After the deadline, connections are closed once their last response arrived.
+    if (!sending) {
+      for (auto& c : connections)
+        if (c.fd >= 0 && c.in_flight == 0) close_connection(c);
+      if (open == 0) break;
+    }
+
+    auto n = ::epoll_wait(epoll, events, max_events, 10);
+    for (int i = 0; i < n; ++i) {
+      auto& c = connections[events[i].data.u64];
+      if (c.fd < 0) continue;
+
+      auto ok = !(events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) || read_responses(c, buffer, stats);
+      if (!ok || !send_requests(opts, c, sending)) {
+        ++stats.errors;
+        close_connection(c);
+        continue;
+      }
+
+      epoll_event ev{};
+      ev.events = EPOLLIN | (c.out.empty() ? 0u : static_cast<uint32_t>(EPOLLOUT));
+      ev.data.u64 = events[i].data.u64;
+      ::epoll_ctl(epoll, EPOLL_CTL_MOD, c.fd, &ev);
+    }
+  }
+
+  for (auto& c : connections)
+    if (c.fd >= 0) ::close(c.fd);
+  ::close(epoll);
+}
+
+void print_usage(const char* program)
+{
+  std::cerr << "Usage: " << program
+            << " [-a ADDRESS] [-p PORT] [-c CONNECTIONS] [-t THREADS] [-P DEPTH] [-d SECONDS] [-f FILE] [-H]"
+               " [PATH...]\n"
+            << "Requests the PATHs, and the paths of FILE, round-robin over CONNECTIONS (16) persistent connections\n"
+            << "to ADDRESS:PORT (127.0.0.1:8080) driven by THREADS (1) threads, with up to DEPTH (1) pipelined\n"
+            << "requests in flight per connection, for SECONDS (10). FILE is a list of paths or an access log.\n"
+            << "Prints the throughput, the response statuses and the latency percentiles, and with -H the\n"
+            << "latency histogram.\n";
+}
+
+options parse_options(int argc, char** argv)
+{
+  options opts;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (arg == "-a" && i + 1 < argc) {
+      opts.address = argv[++i];
+    } else if (arg == "-p" && i + 1 < argc) {
+      opts.port = static_cast<uint16_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "-c" && i + 1 < argc) {
+      opts.connections = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "-t" && i + 1 < argc) {
+      opts.threads = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "-P" && i + 1 < argc) {
+      opts.pipeline = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "-d" && i + 1 < argc) {
+      opts.duration = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "-f" && i + 1 < argc) {
+      auto paths = read_paths(argv[++i]);
+      opts.paths.insert(opts.paths.end(), paths.begin(), paths.end());
+    } else if (arg == "-H") {
+      opts.print_histogram = true;
+    } else if (arg == "-h" || arg == "--help") {
+      print_usage(argv[0]);
+      std::exit(EXIT_SUCCESS);
+    } else if (!arg.empty() && arg.front() == '/') {
+      opts.paths.emplace_back(arg);
+    } else {
+      print_usage(argv[0]);
+      std::exit(EXIT_FAILURE);
+    }
+  }
+  if (opts.paths.empty()) opts.paths = {"/users/42", "/users/42/posts/7", "/static/css/site.css", "/missing"};
+  opts.threads = std::min(opts.threads, opts.connections);
+  return opts;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  options opts;
+  try {
+    opts = parse_options(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<thread_stats> stats(opts.threads);
+  std::atomic<bool> failed{false};
+  auto start = clock_type::now();
+  auto deadline = start + std::chrono::seconds{opts.duration};
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0, first = 0; t < opts.threads; ++t) {
+    auto count = opts.connections / opts.threads + (t < opts.connections % opts.threads ? 1 : 0);
+    threads.emplace_back([&, t, first, count] {
+      try {
+        run_thread(opts, first, count, deadline, stats[t]);
+      } catch (const std::exception& e) {
+        if (!failed.exchange(true)) std::cerr << "Error: " << e.what() << std::endl;
+      }
+    });
+    first += count;
+  }
+  for (auto& thread : threads)
+    thread.join();
+  // The responses drained after the deadline are counted, so is the time spent draining them.
+  auto seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+
+  thread_stats total;
+  for (const auto& s : stats) {
+    total.ok += s.ok;
+    total.not_found += s.not_found;
+    total.other += s.other;
+    total.errors += s.errors;
+    total.latency_ns.merge(s.latency_ns);
+  }
+  if (total.latency_ns.count() == 0) {
+    std::cerr << "No response received" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  auto us = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+  const auto& latency = total.latency_ns;
+  std::printf("%llu requests in %.2f s over %zu connections, %zu threads, pipeline depth %zu: %.0f requests/s\n",
+              static_cast<unsigned long long>(latency.count()), seconds, opts.connections, opts.threads, opts.pipeline,
+              static_cast<double>(latency.count()) / seconds);
+  std::printf("responses: %llu 200, %llu 404, %llu other, %llu failed connections\n",
+              static_cast<unsigned long long>(total.ok), static_cast<unsigned long long>(total.not_found),
+              static_cast<unsigned long long>(total.other), static_cast<unsigned long long>(total.errors));
+  std::printf("latency (us): p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n", us(latency.percentile(0.5)),
+              us(latency.percentile(0.9)), us(latency.percentile(0.99)), us(latency.percentile(0.999)),
+              us(latency.max()));
+  if (opts.print_histogram) latency.print(stdout, 1000.0, "us");
+
+  return failed || total.errors != 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
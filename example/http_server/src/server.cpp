@@ -0,0 +1,421 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <path_to_regex/route_file.hpp>
+
+namespace {
+
+constexpr size_t max_header_size = 16 << 10;
+constexpr size_t max_body_size = 1 << 20;
+constexpr size_t read_size = 16 << 10;
+constexpr int max_events = 256;
+
+constexpr std::string_view default_routes = R"(/                         id=1
+/users                    id=2
+/users/:id                id=3
+/users/:id/posts/:post    id=4
+/static/*path             id=5
+/download/:file{.:ext}    id=6
+/api/:version/status      id=7   case_insensitive
+)";
+
+std::atomic<bool> stopping{false};
+
+struct options {
+  std::string address = "127.0.0.1";
+  uint16_t port = 8080;
+  size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  std::string routes_file;
+  size_t duration = 0;
+};
+
+// Counters of one worker thread, on their own cache line so that workers do not share one.
+struct alignas(64) worker_stats {
+  std::atomic<uint64_t> requests{0};
+  std::atomic<uint64_t> routing_ns{0};
+};
+
+struct connection {
+  std::string in;
+  std::string out;
+  size_t written = 0;
+};
+
+[[noreturn]] void fail(const std::string& what)
+{
+  throw std::runtime_error{what + ": " + std::strerror(errno)};
+}
+
+// Every worker has its own listening socket on the same port, and the kernel spreads
+// incoming connections across them, so that workers never contend on accept.
+int listen_socket(const options& opts)
+{
+  auto fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) fail("socket");
+
+  int one = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  if (::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0) fail("SO_REUSEPORT");
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(opts.port);
+  if (::inet_pton(AF_INET, opts.address.c_str(), &addr.sin_addr) != 1)
+    throw std::runtime_error{"invalid address '" + opts.address + "'"};
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) fail("bind");
+  if (::listen(fd, SOMAXCONN) != 0) fail("listen");
+
+  return fd;
+}
+
+bool iequals(std::string_view lhs, std::string_view rhs)
+{
+  return lhs.size() == rhs.size() &&
+         path_to_regex::details::starts_with(lhs, rhs, path_to_regex::case_sensitivity::case_insensitive);
+}
+
+void append_response(std::string& out, std::string_view status, const std::string& body)
+{
+  out += "HTTP/1.1 ";
+  out += status;
+  out += "\r\nContent-Type: text/plain\r\nContent-Length: ";
+  out += std::to_string(body.size());
+  out += "\r\n\r\n";
+  out += body;
+}
+
+// Handles every complete request in the input buffer, including pipelined ones, and appends
+// the responses to the output buffer. Returns false if the connection must be closed
+// once the responses are written.
+bool handle_requests(connection& c, const path_to_regex::router& router, worker_stats& stats)
+{
+  size_t pos = 0;
+  auto keep_alive = true;
+
+  while (keep_alive) {
+    auto head_end = c.in.find("\r\n\r\n", pos);
+    if (head_end == std::string::npos) {
+      if (c.in.size() - pos > max_header_size) {
+        append_response(c.out, "431 Request Header Fields Too Large", "header too large\n");
+        keep_alive = false;
+      }
+      break;
+    }
+
+    std::string_view head{c.in.data() + pos, head_end - pos};
+    auto line_end = std::min(head.find("\r\n"), head.size());
+    std::string_view line = head.substr(0, line_end);
+    auto method_end = line.find(' ');
+    auto target_end = line.rfind(' ');
+    if (method_end == std::string_view::npos || target_end <= method_end) {
+      append_response(c.out, "400 Bad Request", "bad request\n");
+      keep_alive = false;
+      break;
+    }
+    auto target = line.substr(method_end + 1, target_end - method_end - 1);
+    auto version = line.substr(target_end + 1);
+    keep_alive = version == "HTTP/1.1";
+
+    size_t content_length = 0;
+    auto valid_length = true;
+    for (size_t start = line_end + 2; start < head.size();) {
+      auto end = std::min(head.find("\r\n", start), head.size());
+      auto header = head.substr(start, end - start);
+      start = end + 2;
+
+      auto colon = header.find(':');
+      if (colon == std::string_view::npos) continue;
+      auto name = header.substr(0, colon);
+      auto value = header.substr(colon + 1);
+      while (!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+        value.remove_prefix(1);
+      while (!value.empty() && (value.back() == ' ' || value.back() == '\t'))
+        value.remove_suffix(1);
+
+      if (iequals(name, "content-length")) {
+        auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), content_length);
+        valid_length = ec == std::errc{} && end == value.data() + value.size();
+      }
+      if (iequals(name, "connection"))
+        keep_alive = iequals(value, "keep-alive") || (keep_alive && !iequals(value, "close"));
+    }
+
+    if (!valid_length) {
+      append_response(c.out, "400 Bad Request", "bad content length\n");
+      keep_alive = false;
+      break;
+    }
+    if (content_length > max_body_size) {
+      append_response(c.out, "413 Content Too Large", "body too large\n");
+      keep_alive = false;
+      break;
+    }
+
+    // The body is not used, but it has to be received before the next request starts.
+    if (content_length > c.in.size() - head_end - 4) break;
+    pos = head_end + 4 + content_length;
+
+    auto path = target.substr(0, target.find('?'));
+    auto start = std::chrono::steady_clock::now();
+    auto res = router(path);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    stats.requests.fetch_add(1, std::memory_order_relaxed);
+    stats.routing_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                               std::memory_order_relaxed);
+
+    if (!res.matched) {
+      append_response(c.out, "404 Not Found", "not found\n");
+      continue;
+    }
+
+    std::string body = "route " + std::to_string(res.id) + "\n";
+    for (const auto& [key, value] : res.params)
+      body += key + "=" + value + "\n";
+    append_response(c.out, "200 OK", body);
+  }
+
+  c.in.erase(0, pos);
+  return keep_alive;
+}
+
+// Writes as much of the output buffer as the socket takes. Returns false on error.
+bool flush(int fd, connection& c)
+{
+  while (c.written < c.out.size()) {
+    auto n = ::send(fd, c.out.data() + c.written, c.out.size() - c.written, MSG_NOSIGNAL);
+    if (n < 0) return errno == EAGAIN || errno == EWOULDBLOCK;
+    c.written += static_cast<size_t>(n);
+  }
+  c.out.clear();
+  c.written = 0;
+  return true;
+}
+
+void run_worker(int listener, const path_to_regex::router& router, worker_stats& stats)
+{
+  auto epoll = ::epoll_create1(EPOLL_CLOEXEC);
+  if (epoll < 0) fail("epoll_create1");
+
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = listener;
+  ::epoll_ctl(epoll, EPOLL_CTL_ADD, listener, &ev);
+
+  std::unordered_map<int, connection> connections;
+  std::vector<char> buffer(read_size);
+  epoll_event events[max_events];
+
+  auto close_connection = [&](int fd) {
+    ::epoll_ctl(epoll, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections.erase(fd);
+  };
+
+  while (!stopping.load(std::memory_order_relaxed)) {
+    auto count = ::epoll_wait(epoll, events, max_events, 100);
+    for (int i = 0; i < count; ++i) {
+      auto fd = events[i].data.fd;
+
+      if (fd == listener) {
+        for (;;) {
+          auto client = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+          if (client < 0) break;
+          int one = 1;
+          ::setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+          epoll_event client_ev{};
+          client_ev.events = EPOLLIN | EPOLLRDHUP;
+          client_ev.data.fd = client;
+          ::epoll_ctl(epoll, EPOLL_CTL_ADD, client, &client_ev);
+          connections.emplace(client, connection{});
+        }
+        continue;
+      }
+
+      auto& c = connections[fd];
+      auto keep_alive = true;
+
+      if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+        for (;;) {
+          auto n = ::recv(fd, buffer.data(), buffer.size(), 0);
+          if (n > 0) {
+            c.in.append(buffer.data(), static_cast<size_t>(n));
+            continue;
+          }
+          if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) keep_alive = false;
+          break;
+        }
+        if (!handle_requests(c, router, stats)) keep_alive = false;
+      }
+
+      if (!flush(fd, c) || (!keep_alive && c.out.empty())) {
+        close_connection(fd);
+        continue;
+      }
+
+      // Waits for the socket to become writable only while responses are pending.
+      epoll_event client_ev{};
+      client_ev.events = EPOLLIN | EPOLLRDHUP | (c.out.empty() ? 0u : static_cast<uint32_t>(EPOLLOUT));
+      client_ev.data.fd = fd;
+      ::epoll_ctl(epoll, EPOLL_CTL_MOD, fd, &client_ev);
+    }
+  }
+
+  for (const auto& [fd, c] : connections)
+    ::close(fd);
+  ::close(epoll);
+}
+
+void print_usage(const char* program)
+{
+  std::cerr << "Usage: " << program << " [-a ADDRESS] [-p PORT] [-t THREADS] [-d SECONDS] [ROUTES]\n"
+            << "Serves HTTP/1.1 on ADDRESS:PORT (127.0.0.1:8080), routing every request with a router\n"
+            << "built from the ROUTES route file or from built-in routes, and prints the requests\n"
+            << "per second and the routing time per request every second. Stops after SECONDS if given.\n";
+}
+
+options parse_options(int argc, char** argv)
+{
+  options opts;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (arg == "-a" && i + 1 < argc) {
+      opts.address = argv[++i];
+    } else if (arg == "-p" && i + 1 < argc) {
+      opts.port = static_cast<uint16_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "-t" && i + 1 < argc) {
+      opts.threads = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "-d" && i + 1 < argc) {
+      opts.duration = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "-h" || arg == "--help") {
+      print_usage(argv[0]);
+      std::exit(EXIT_SUCCESS);
+    } else if (!arg.empty() && arg.front() != '-' && opts.routes_file.empty()) {
+      opts.routes_file = arg;
+    } else {
+      print_usage(argv[0]);
+      std::exit(EXIT_FAILURE);
+    }
+  }
+  return opts;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  auto opts = parse_options(argc, argv);
+
+  std::string text{default_routes};
+  if (!opts.routes_file.empty()) {
+    std::ifstream in{opts.routes_file};
+    if (!in) {
+      std::cerr << "Cannot open " << opts.routes_file << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    text = contents.str();
+  }
+
+  auto file = path_to_regex::parse_route_file(text);
+  if (!file.ok()) {
+    for (const auto& error : file.errors)
+      std::cerr << opts.routes_file << ":" << error.line << ":" << error.column << ": " << error.message << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    const path_to_regex::router router{file.routes, opts.threads};
+
+    std::vector<int> listeners;
+    for (size_t i = 0; i < opts.threads; ++i)
+      listeners.push_back(listen_socket(opts));
+
+    std::signal(SIGINT, [](int) { stopping = true; });
+    std::signal(SIGTERM, [](int) { stopping = true; });
+
+    std::vector<worker_stats> stats(opts.threads);
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < opts.threads; ++i)
+      workers.emplace_back(run_worker, listeners[i], std::cref(router), std::ref(stats[i]));
+
+    std::cout << "Serving " << file.routes.size() << " routes on " << opts.address << ":" << opts.port << " with "
+              << opts.threads << " threads" << std::endl;
+
+    uint64_t last_requests = 0;
+    uint64_t last_routing_ns = 0;
+    for (size_t second = 1; !stopping; ++second) {
+      for (int i = 0; i < 10 && !stopping; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+      uint64_t requests = 0;
+      uint64_t routing_ns = 0;
+      for (const auto& s : stats) {
+        requests += s.requests.load(std::memory_order_relaxed);
+        routing_ns += s.routing_ns.load(std::memory_order_relaxed);
+      }
+      auto delta = requests - last_requests;
+      if (delta != 0) {
+        std::printf("%10llu requests/s %10.1f ns routing/request\n", static_cast<unsigned long long>(delta),
+                    static_cast<double>(routing_ns - last_routing_ns) / static_cast<double>(delta));
+        std::fflush(stdout);
+      }
+      last_requests = requests;
+      last_routing_ns = routing_ns;
+
+      if (opts.duration != 0 && second >= opts.duration) stopping = true;
+    }
+
+    for (auto& worker : workers)
+      worker.join();
+    for (auto fd : listeners)
+      ::close(fd);
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,344 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include "differential.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <regex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <path_to_regex.hpp>
+#include <path_to_regex/batch.hpp>
+#include <path_to_regex/chain.hpp>
+#include <path_to_regex/native.hpp>
+#include <path_to_regex/router.hpp>
+
+namespace {
+
+using path_to_regex::case_sensitivity;
+using params_type = std::unordered_map<std::string, std::string>;
+
+struct generated_input {
+  std::string pattern;
+  std::vector<std::string> paths;
+  case_sensitivity sensitivity = case_sensitivity::case_sensitive;
+};
+
+// Turns the fuzzer input into a stream of choices. Exhausted input yields zeros.
+class choices {
+public:
+  choices(const uint8_t* data, size_t size)
+    : m_data{data}
+    , m_size{size}
+  {}
+
+  size_t below(size_t n)
+  {
+    if (n <= 1) return 0;
+    return m_pos < m_size ? m_data[m_pos++] % n : 0;
+  }
+
+  bool chance(size_t percent)
+  {
+    return below(100) < percent;
+  }
+
+  bool exhausted() const
+  {
+    return m_pos >= m_size;
+  }
+
+private:
+  const uint8_t* m_data;
+  size_t m_size;
+  size_t m_pos = 0;
+};
+
+// Characters covering the encoding edge cases: case folding, characters that are
+// percent-encoded, already encoded sequences, regex special characters and delimiters.
+constexpr std::string_view fragments[] = {
+  "a", "b", "Z", "0", "7", "-", ".", "_", "~", "%", "%C3%A9", "%c3%a9", "\xC3\xA9", " ", "%20",
+  "+", "$", "^", "(", ")", "[", "]", "|", "?", "#", ":", "*", "@", "!", "=", ",", ";", "'",
+};
+constexpr std::string_view names[] = {"id", "x", "caf%C3%A9", "caf\xC3\xA9", "a_1"};
+constexpr std::string_view subpatterns[] = {"(\\d+)", "([a-z]+)", "(a|b)", "(\\d{1,2})", "(.*)"};
+
+std::string make_literal(choices& in, char separator)
+{
+  std::string literal;
+  auto count = 1 + in.below(4);
+  for (size_t i = 0; i < count; ++i)
+    literal += in.chance(20) ? std::string(1, separator) : std::string{fragments[in.below(std::size(fragments))]};
+  return literal;
+}
+
+std::string make_pieces(choices& in, char separator, bool custom, bool optional)
+{
+  std::string pattern;
+  auto count = 1 + in.below(5);
+  for (size_t i = 0; i < count; ++i) {
+    switch (in.below(optional ? 6 : 5)) {
+    case 0:
+    case 1:
+      pattern += separator;
+      pattern += make_literal(in, separator);
+      break;
+    case 2:
+      pattern += separator;
+      pattern += ':';
+      pattern += names[in.below(std::size(names))];
+      if (custom && in.chance(30)) pattern += subpatterns[in.below(std::size(subpatterns))];
+      break;
+    case 3:
+      pattern += separator;
+      pattern += '*';
+      pattern += names[in.below(std::size(names))];
+      break;
+    case 4:
+      pattern += in.chance(50) ? "." : "-";
+      pattern += ':';
+      pattern += names[in.below(std::size(names))];
+      break;
+    case 5:
+      pattern += '{' + make_pieces(in, separator, custom, false) + '}';
+      break;
+    }
+  }
+  if (in.chance(20)) pattern += separator;
+  return pattern;
+}
+
+// Derives a path from the pattern so that a good share of the paths match.
+std::string make_path(choices& in, std::string_view pattern, char separator)
+{
+  std::string path;
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    auto ch = pattern[i];
+    if ((ch == ':' || ch == '*') && i + 1 < pattern.size() && path_to_regex::details::is_name_char(pattern[i + 1])) {
+      while (i + 1 < pattern.size() && path_to_regex::details::is_name_char(pattern[i + 1]))
+        ++i;
+      if (ch == '*' && in.chance(50)) {
+        path += make_literal(in, separator) + separator + make_literal(in, separator);
+      } else {
+        path += in.chance(50) ? std::string{"42"} : make_literal(in, separator);
+      }
+      if (i + 1 < pattern.size() && pattern[i + 1] == '(') {
+        auto close = pattern.find(')', i);
+        if (close != std::string_view::npos) i = close;
+      }
+    } else if (ch == '{' || ch == '}') {
+      if (ch == '{' && in.chance(40)) {
+        auto close = pattern.find('}', i);
+        if (close != std::string_view::npos) i = close;
+      }
+    } else if (in.chance(3)) {
+      path += fragments[in.below(std::size(fragments))];
+    } else if (!in.chance(2)) {
+      path += in.chance(10) ? path_to_regex::details::to_lower_ascii(ch) : ch;
+    }
+  }
+  if (in.chance(20)) path += separator;
+  return path;
+}
+
+std::string describe(bool matched, const params_type& params)
+{
+  std::string text = matched ? "matched {" : "not matched {";
+  std::map<std::string, std::string> sorted{params.begin(), params.end()};
+  for (const auto& [key, value] : sorted)
+    text += key + "=" + value + ";";
+  return text + "}";
+}
+
+struct verdict {
+  std::string engine;
+  std::string expected;
+  std::string actual;
+};
+
+// Runs a pattern and a path through the reference std::regex matcher and every other engine.
+// Returns the first engine disagreeing with the reference, or an empty engine name.
+verdict compare(const std::string& pattern, const std::string& path, case_sensitivity sensitivity)
+{
+  std::optional<path_to_regex::matcher> reference;
+  try {
+    reference = path_to_regex::match(pattern, sensitivity);
+  } catch (const std::regex_error&) {
+    auto compiled = path_to_regex::try_match(pattern, sensitivity);
+    if (compiled) return {"try_match", "regex_error", "compiled"};
+    return {};
+  }
+
+  auto expected = (*reference)(path);
+  auto expected_text = describe(expected.matched, expected.params);
+  auto check = [&](const char* engine, bool matched, const params_type& params) -> verdict {
+    if (matched == expected.matched && (!matched || params == expected.params)) return {};
+    return {engine, expected_text, describe(matched, params)};
+  };
+
+  path_to_regex::matcher::result res;
+  if (reference->try_match(path, res) != path_to_regex::match_status::ok)
+    return {"try_match", expected_text, "aborted"};
+  if (auto v = check("try_match", res.matched, res.params); !v.engine.empty()) return v;
+
+  try {
+    auto native = path_to_regex::native::match(pattern, sensitivity)(path);
+    if (auto v = check("native", native.matched, native.params); !v.engine.empty()) return v;
+  } catch (const std::invalid_argument&) {
+    // Custom subpatterns are not supported by the native engine.
+  }
+
+  path_to_regex::router router{{{pattern, 1, sensitivity}}};
+  auto routed = router(path);
+  if (auto v = check("router", routed.matched, routed.params); !v.engine.empty()) return v;
+
+  path_to_regex::chain_resolver chain{{{pattern, 1, path_to_regex::match_mode::full, sensitivity}}};
+  auto resolved = chain(path);
+  if (auto v = check("chain_resolver", !resolved.empty(), resolved.empty() ? params_type{} : resolved.front().params);
+      !v.engine.empty())
+    return v;
+
+  path_to_regex::batch_matcher batch{*reference};
+  std::vector<path_to_regex::matcher::result> results;
+  batch({path, path}, results);
+  for (const auto& r : results)
+    if (auto v = check("batch_matcher", r.matched, r.params); !v.engine.empty()) return v;
+
+  return {};
+}
+
+// Removes characters from the pattern and the path as long as the same engine disagrees.
+void minimize(std::string& pattern, std::string& path, case_sensitivity sensitivity, const std::string& engine)
+{
+  auto shrink = [&](std::string& text) {
+    auto changed = false;
+    for (size_t i = 0; i < text.size();) {
+      auto candidate = text;
+      candidate.erase(i, 1);
+      auto saved = text;
+      text = candidate;
+      if (compare(pattern, path, sensitivity).engine == engine) {
+        changed = true;
+      } else {
+        text = saved;
+        ++i;
+      }
+    }
+    return changed;
+  };
+
+  while (shrink(pattern) || shrink(path)) {
+  }
+}
+
+std::string quote(std::string_view text)
+{
+  std::string quoted = "\"";
+  for (unsigned char ch : text) {
+    if (ch == '"' || ch == '\\') {
+      quoted += '\\';
+      quoted += static_cast<char>(ch);
+    } else if (ch < 0x20 || ch >= 0x7F) {
+      char escaped[5];
+      std::snprintf(escaped, sizeof(escaped), "\\x%02X", ch);
+      quoted += escaped;
+    } else {
+      quoted += static_cast<char>(ch);
+    }
+  }
+  return quoted + "\"";
+}
+
+// Generates a pattern and up to four paths derived from it from the fuzzer input.
+generated_input generate(const uint8_t* data, size_t size)
+{
+  choices in{data, size};
+
+  generated_input input;
+  auto separator = in.chance(25) ? '\\' : '/';
+  input.sensitivity = in.chance(30) ? case_sensitivity::case_insensitive : case_sensitivity::case_sensitive;
+  input.pattern = make_pieces(in, separator, in.chance(30), true);
+
+  for (size_t i = 0; i < 4 && (i == 0 || !in.exhausted()); ++i)
+    input.paths.push_back(in.chance(80) ? make_path(in, input.pattern, separator)
+                                        : make_pieces(in, separator, false, false));
+
+  return input;
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  auto input = generate(data, size);
+  auto& pattern = input.pattern;
+  auto sensitivity = input.sensitivity;
+
+  for (auto& path : input.paths) {
+    auto v = compare(pattern, path, sensitivity);
+    if (v.engine.empty()) continue;
+
+    minimize(pattern, path, sensitivity, v.engine);
+    v = compare(pattern, path, sensitivity);
+    std::fprintf(stderr, "%s disagrees with std::regex\n  pattern: %s\n  path: %s\n  sensitivity: %s\n",
+                 v.engine.c_str(), quote(pattern).c_str(), quote(path).c_str(),
+                 sensitivity == case_sensitivity::case_sensitive ? "case_sensitive" : "case_insensitive");
+    std::fprintf(stderr, "  expected: %s\n  actual: %s\n", v.expected.c_str(), v.actual.c_str());
+    std::abort();
+  }
+
+  return 0;
+}
+
+size_t write_corpus_cases(const uint8_t* data, size_t size, std::set<std::string>& written, std::FILE* out)
+{
+  auto input = generate(data, size);
+
+  std::optional<path_to_regex::matcher> matcher;
+  try {
+    matcher = path_to_regex::match(input.pattern, input.sensitivity);
+  } catch (const std::regex_error&) {
+    return 0;
+  }
+
+  size_t count = 0;
+  for (const auto& path : input.paths) {
+    path_to_regex::matcher::result res;
+    if (matcher->try_match(path, res) != path_to_regex::match_status::ok) continue;
+    if (!compare(input.pattern, path, input.sensitivity).engine.empty()) continue;
+
+    auto line = quote(input.pattern) + ' ' + quote(path) + (res.matched ? " match" : " miss");
+    if (input.sensitivity == case_sensitivity::case_insensitive) line += " ci";
+    std::map<std::string, std::string> sorted{res.params.begin(), res.params.end()};
+    for (const auto& [key, value] : sorted)
+      line += ' ' + quote(key) + '=' + quote(value);
+
+    if (!written.insert(line).second) continue;
+    std::fprintf(out, "%s\n", line.c_str());
+    ++count;
+  }
+
+  return count;
+}
@@ -0,0 +1,34 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_FUZZ_DIFFERENTIAL_H
+#define PATH_TO_REGEX_FUZZ_DIFFERENTIAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <set>
+#include <string>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+// Writes the cases generated from a fuzzer input to `out` in the format of tests/data/cases.txt,
+// with the result of the std::regex matcher as the expectation. Lines already in `written` are skipped.
+// Returns the number of written cases.
+size_t write_corpus_cases(const uint8_t* data, size_t size, std::set<std::string>& written, std::FILE* out);
+
+#endif // PATH_TO_REGEX_FUZZ_DIFFERENTIAL_H
@@ -0,0 +1,101 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include "differential.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+void print_usage(const char* program)
+{
+  std::fprintf(stderr, "Usage: %s [-n ITERATIONS] [-s SEED] [--corpus CASES] [FILE...]\n", program);
+  std::fprintf(stderr, "Runs FILEs as fuzzer inputs, or ITERATIONS random inputs if no FILE is given.\n");
+  std::fprintf(stderr, "With --corpus, prints CASES generated test cases in the test corpus format instead.\n");
+}
+
+} // namespace
+
+// Standalone driver for compilers without libFuzzer: replays inputs or runs random ones.
+int main(int argc, char** argv)
+{
+  size_t iterations = 10000;
+  size_t corpus = 0;
+  unsigned long seed = std::random_device{}();
+  std::vector<std::string> files;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (arg == "-n" && i + 1 < argc) {
+      iterations = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "-s" && i + 1 < argc) {
+      seed = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "--corpus" && i + 1 < argc) {
+      corpus = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "-h" || arg == "--help") {
+      print_usage(argv[0]);
+      return EXIT_SUCCESS;
+    } else {
+      files.emplace_back(arg);
+    }
+  }
+
+  for (const auto& file : files) {
+    std::ifstream in{file, std::ios::binary};
+    if (!in) {
+      std::fprintf(stderr, "Cannot open %s\n", file.c_str());
+      return EXIT_FAILURE;
+    }
+    std::vector<uint8_t> data{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+  }
+  if (!files.empty()) return EXIT_SUCCESS;
+
+  std::mt19937 random{static_cast<std::mt19937::result_type>(seed)};
+  std::vector<uint8_t> data;
+
+  if (corpus != 0) {
+    std::printf("# Generated by `path_to_regex_fuzz_differential --corpus %zu -s %lu`, do not edit.\n", corpus, seed);
+    std::set<std::string> written;
+    for (size_t count = 0; count < corpus;) {
+      data.resize(random() % 128);
+      for (auto& byte : data)
+        byte = static_cast<uint8_t>(random());
+      count += write_corpus_cases(data.data(), data.size(), written, stdout);
+    }
+    return EXIT_SUCCESS;
+  }
+
+  std::printf("seed %lu\n", seed);
+  for (size_t i = 0; i < iterations; ++i) {
+    data.resize(random() % 128);
+    for (auto& byte : data)
+      byte = static_cast<uint8_t>(random());
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+  }
+  std::printf("%zu inputs, no disagreement\n", iterations);
+
+  return EXIT_SUCCESS;
+}
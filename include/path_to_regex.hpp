@@ -18,146 +18,117 @@
 #ifndef PATH_TO_REGEX_H
 #define PATH_TO_REGEX_H
 
-#include <regex>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
-namespace path_to_regex {
+#include <path_to_regex/common.hpp>
+#include <path_to_regex/details/tokenizer.hpp>
 
-/**
- * @enum case_sensitivity
- * @brief Enum class to specify case sensitivity options.
- *
- * Indicates whether path comparison should be case-sensitive or case-insensitive.
- */
-enum class case_sensitivity {
-  case_sensitive,  ///< Path comparison should consider the case of the characters.
-  case_insensitive ///< Path comparison should ignore the case of the characters.
-};
+// With PATH_TO_REGEX_COMPILED, set by the `path_to_regex::compiled` target, the functions
+// instantiating the regex engine are defined once in the compiled library instead of inline,
+// and `<regex>` is only included by the library.
+#ifdef PATH_TO_REGEX_COMPILED
+#define PATH_TO_REGEX_INLINE
+#else
+#define PATH_TO_REGEX_INLINE inline
+#endif
+
+#if !defined(PATH_TO_REGEX_COMPILED) || defined(PATH_TO_REGEX_IMPLEMENTATION)
+#include <regex>
+#endif
 
+namespace path_to_regex {
 namespace details {
 
-inline std::string percent_encode(std::string_view str)
+PATH_TO_REGEX_INLINE std::string make_pattern(const std::string& path, std::vector<std::string>& keys, char separator);
+
+inline std::string make_pattern(std::string_view path, std::vector<std::string>& keys)
 {
-  constexpr auto hex_chars = "0123456789ABCDEF";
-  constexpr std::string_view special_chars = R"(!"#$%&'()*+,-./:;<=>?@[\]^_{|}~`)";
-
-  std::string encoded;
-  encoded.reserve(str.size() * 3);
-
-  for (unsigned char ch : str) {
-    if (std::isalnum(ch) || special_chars.find(ch) != std::string_view::npos) {
-      encoded.push_back(ch);
-    } else {
-      encoded.push_back('%');
-      encoded.push_back(hex_chars[ch >> 4]);
-      encoded.push_back(hex_chars[ch & 0x0F]);
-    }
+  auto encoded_path = percent_encode(path);
+  auto separator = find_separator(path);
+  auto pattern = make_pattern(encoded_path, keys, separator);
+  if (pattern.empty() || pattern.back() != separator) {
+    pattern += '\\';
+    pattern += separator;
   }
-
-  return encoded;
+  return '^' + pattern + "?$";
 }
 
-inline std::string percent_decode(std::string_view str)
+inline std::string make_prefix_pattern(std::string_view path, std::vector<std::string>& keys)
 {
-  std::string decoded;
-  decoded.reserve(str.size());
-
-  for (size_t i = 0; i < str.size();) {
-    if (str[i] == '%' && i + 2 < str.size() && std::isxdigit(str[i + 1]) && std::isxdigit(str[i + 2])) {
-      char ch = 0;
-      for (int j = 1; j < 3; ++j) {
-        ch <<= 4;
-        char hex = str[i + j];
-        ch |= (hex >= '0' && hex <= '9') ? (hex - '0') : (std::toupper(hex) - 'A' + 10);
-      }
-      decoded.push_back(ch);
-      i += 3;
-    } else {
-      decoded.push_back(str[i]);
-      ++i;
-    }
+  auto encoded_path = percent_encode(path);
+  auto separator = find_separator(path);
+  auto pattern = make_pattern(encoded_path, keys, separator);
+  if (!pattern.empty() && pattern.back() == separator) {
+    pattern.pop_back();
+    if (separator == '\\') pattern.pop_back();
   }
-
-  return decoded;
+  pattern += "(?:\\";
+  pattern += separator;
+  pattern += ".*)?$";
+  return '^' + pattern;
 }
 
-inline char find_separator(std::string_view path)
+inline bool is_text_delimiter(unsigned char ch)
 {
-  return (path.find('/') <= path.find('\\')) ? '/' : '\\';
+  return ch <= ' ' || ch == 0x7F || ch == '"' || ch == '\'' || ch == '<' || ch == '>' || ch == '`' || ch == '?' ||
+         ch == '#';
 }
 
-inline std::string make_pattern(const std::string& path, std::vector<std::string>& keys, char separator)
+inline bool is_regex_quantifier(char ch)
 {
-  // Regex pattern structure:    | Optional |      Required       | Wildcard |    Special Chars    |
-  static auto rx = std::regex{R"(\{([^}]*)\}|:([\w%]+)(\([^)]+\))?|\*([\w%]+)|([.\^$*+?()|\[\]{}\\]))"};
-  std::sregex_iterator it{path.cbegin(), path.cend(), rx};
-  std::sregex_iterator end;
-  size_t last_pos = 0;
-  std::string pattern;
+  return ch == '?' || ch == '*' || ch == '+' || ch == '{';
+}
 
-  constexpr auto optional_param_key_idx = 1;
-  constexpr auto required_param_key_idx = 2;
-  constexpr auto required_param_pattern_idx = 3;
-  constexpr auto wildcard_param_key_idx = 4;
-  constexpr auto special_chars_key_idx = 5;
+inline std::string literal_prefix(std::string_view pattern)
+{
+  constexpr std::string_view stop_chars = ".^$*+?()[]{}|%";
 
-  for (; it != end; ++it) {
-    auto match = *it;
+  std::string prefix;
+  size_t i = (!pattern.empty() && pattern.front() == '^') ? 1 : 0;
 
-    if (last_pos < match.position()) pattern += path.substr(last_pos, match.position() - last_pos);
+  while (i < pattern.size()) {
+    auto ch = pattern[i];
+    auto next = i + 1;
 
-    if (match[optional_param_key_idx].matched) {
-      auto subpattern = make_pattern(match[optional_param_key_idx].str(), keys, separator);
-      if (!subpattern.empty()) pattern += "(?:" + subpattern + ")?";
-    } else if (match[required_param_key_idx].matched) {
-      keys.push_back(percent_decode(match[required_param_key_idx].str()));
-      auto subpattern = match[required_param_pattern_idx].str();
-      if (subpattern.empty()) {
-        pattern += "([^\\";
-        pattern += separator;
-        pattern += "]+?)";
-      } else {
-        pattern += subpattern;
-      }
-    } else if (match[wildcard_param_key_idx].matched) {
-      keys.push_back(percent_decode(match[wildcard_param_key_idx].str()));
-      pattern += "(\\S+?)";
-    } else if (match[special_chars_key_idx].matched) {
-      pattern += '\\';
-      pattern += match[special_chars_key_idx].str();
+    if (ch == '\\') {
+      if (next == pattern.size() || std::isalnum(static_cast<unsigned char>(pattern[next]))) break;
+      ch = pattern[next++];
+    } else if (stop_chars.find(ch) != std::string_view::npos) {
+      break;
     }
 
-    last_pos = match.position() + match.length();
-  }
-
-  if (last_pos < path.length()) pattern += path.substr(last_pos, path.length() - last_pos);
+    if (next < pattern.size() && is_regex_quantifier(pattern[next])) break;
 
-  return pattern;
-}
-
-inline std::string make_pattern(std::string_view path, std::vector<std::string>& keys)
-{
-  auto encoded_path = percent_encode(path);
-  auto separator = find_separator(path);
-  auto pattern = make_pattern(encoded_path, keys, separator);
-  if (pattern.empty() || pattern.back() != separator) {
-    pattern += '\\';
-    pattern += separator;
+    prefix.push_back(ch);
+    i = next;
   }
-  return '^' + pattern + "?$";
-}
 
-inline std::regex_constants::syntax_option_type make_regex_flags(path_to_regex::case_sensitivity sensitivity)
-{
-  auto flags = std::regex_constants::ECMAScript;
-  if (sensitivity == path_to_regex::case_sensitivity::case_insensitive) flags |= std::regex_constants::icase;
-  return flags;
+  return prefix;
 }
 
+// Compiled regular expression of a matcher, only defined where the regex engine is.
+struct compiled_regex;
+
 } // namespace details
 
+/**
+ * @enum match_status
+ * @brief Outcome of the non-throwing compile and match operations.
+ */
+enum class match_status {
+  ok,              ///< The operation succeeded.
+  invalid_pattern, ///< A custom subpattern is not a valid regular expression.
+  complexity,      ///< The regex engine gave up because the match was too complex.
+  stack,           ///< The regex engine ran out of stack space.
+  out_of_memory    ///< Memory allocation failed.
+};
+
 /**
  * @class matcher
  * @brief Matches paths against a compiled regular expression pattern.
@@ -178,11 +149,19 @@ public:
     std::unordered_map<std::string, std::string> params; ///< Extracted params from the matched path.
   };
 
-  matcher(std::string pattern, std::vector<std::string> keys, case_sensitivity sensitivity)
-    : m_pattern{std::move(pattern)}
-    , m_regex{m_pattern, details::make_regex_flags(sensitivity)}
-    , m_keys{std::move(keys)}
-  {}
+  /**
+   * @struct search_result
+   * @brief Occurrence of the pattern found in a larger text.
+   *
+   * Describes the span of the matched path within the searched text and the params extracted from it.
+   */
+  struct search_result {
+    size_t position = 0;                                 ///< Offset of the matched path in the text.
+    size_t length = 0;                                   ///< Length of the matched path in the text.
+    std::unordered_map<std::string, std::string> params; ///< Extracted params from the matched path.
+  };
+
+  PATH_TO_REGEX_INLINE matcher(std::string pattern, std::vector<std::string> keys, case_sensitivity sensitivity);
 
   /**
    * @brief Matches a path against the compiled pattern.
@@ -194,19 +173,56 @@ public:
    *
    * @see result
    */
-  matcher::result operator()(std::string_view path) const
+  PATH_TO_REGEX_INLINE matcher::result operator()(std::string_view path) const;
+
+  /**
+   * @brief Matches a path against the compiled pattern without throwing.
+   *
+   * Same as `operator()`, but regex engine aborts and allocation failures are reported
+   * as a status instead of an exception.
+   *
+   * @param path Path to match.
+   * @param res Receives the match status and params. Left unmatched on failure.
+   * @return `match_status::ok` if the match completed, whether the path matched or not.
+   */
+  PATH_TO_REGEX_INLINE match_status try_match(std::string_view path, result& res) const noexcept;
+
+  /**
+   * @brief Finds all non-overlapping occurrences of the pattern in a text.
+   *
+   * The text is split into path-like words at whitespace, control characters, quotes, angle brackets,
+   * backticks, `?` and `#`. A match starts at an occurrence of the pattern's leading literal (or, if the
+   * pattern has none, at the start of a word or at a separator) and must extend to the end of its word.
+   * Occurrences of the leading literal are located with `std::string_view::find`, so text without
+   * candidates is skipped at `memchr` speed.
+   *
+   * @param text Text to search, e.g. a log line or a header value.
+   * @return The matches in order of their position in the text.
+   *
+   * @see search_result
+   */
+  std::vector<search_result> search(std::string_view text) const
   {
-    auto encoded_path = details::percent_encode(path);
+    std::vector<search_result> results;
 
-    std::smatch match;
-    result res = {std::regex_match(encoded_path, match, m_regex)};
+    for (size_t pos = 0; pos < text.size();) {
+      auto start = find_candidate(text, pos);
+      if (start == std::string_view::npos) break;
 
-    if (res.matched) {
-      for (size_t i = 0; i < m_keys.size(); ++i)
-        res.params[m_keys[i]] = details::percent_decode(match[i + 1].str());
+      auto end = start;
+      while (end < text.size() && !details::is_text_delimiter(text[end]))
+        ++end;
+
+      auto res = (*this)(text.substr(start, end - start));
+      if (res.matched) {
+        results.push_back({start, end - start, std::move(res.params)});
+        pos = end;
+      } else {
+        pos = start + 1;
+      }
     }
 
-    return res;
+    return results;
   }
 
   /**
@@ -219,10 +235,53 @@ public:
     return m_pattern;
   }
 
+  /**
+   * @brief Returns the literal text every matching path starts with.
+   *
+   * Compared case-insensitively for case-insensitive matchers. May be empty.
+   *
+   * @return The leading literal of the pattern.
+   */
+  std::string prefix() const
+  {
+    return m_prefix;
+  }
+
+  /**
+   * @brief Returns the case sensitivity the matcher was compiled with.
+   *
+   * @return The case sensitivity option.
+   */
+  case_sensitivity sensitivity() const
+  {
+    return m_sensitivity;
+  }
+
 private:
+  size_t find_candidate(std::string_view text, size_t pos) const
+  {
+    if (m_prefix.empty()) {
+      for (; pos < text.size(); ++pos) {
+        auto ch = text[pos];
+        if (details::is_text_delimiter(ch)) continue;
+        if (pos == 0 || details::is_text_delimiter(text[pos - 1]) || ch == '/' || ch == '\\') return pos;
+      }
+      return std::string_view::npos;
+    }
+
+    if (m_sensitivity == case_sensitivity::case_sensitive) return text.find(m_prefix, pos);
+
+    auto it = std::search(text.begin() + pos, text.end(), m_prefix.begin(), m_prefix.end(), [](char lhs, char rhs) {
+      return details::to_lower_ascii(lhs) == details::to_lower_ascii(rhs);
+    });
+    return it == text.end() ? std::string_view::npos : static_cast<size_t>(it - text.begin());
+  }
+
   std::string m_pattern;
-  std::regex m_regex;
+  std::shared_ptr<const details::compiled_regex> m_regex; ///< Immutable, so copies share it.
   std::vector<std::string> m_keys;
+  std::string m_prefix;
+  case_sensitivity m_sensitivity;
 };
 
 /**
@@ -245,6 +304,252 @@ inline matcher match(std::string_view path, case_sensitivity sensitivity = case_
   return {std::move(pattern), std::move(keys), sensitivity};
 }
 
+/**
+ * @brief Compiles a path pattern matching paths it is a prefix of.
+ *
+ * The pattern matches a path if it matches the whole path or the part of it
+ * preceding a separator, like an Express mount path: `/api` matches `/api`
+ * and `/api/users` but not `/apikeys`. A trailing wildcard only captures up to
+ * the next separator.
+ *
+ * @param path The path pattern.
+ * @param sensitivity The case sensitivity option for matching.
+ *                    Defaults to `case_sensitivity::case_sensitive`.
+ * @return A `matcher` object with the compiled regular expression.
+ *
+ * @see match
+ */
+inline matcher match_prefix(std::string_view path, case_sensitivity sensitivity = case_sensitivity::case_sensitive)
+{
+  std::vector<std::string> keys;
+  auto pattern = details::make_prefix_pattern(path, keys);
+  return {std::move(pattern), std::move(keys), sensitivity};
+}
+
+/**
+ * @struct compile_result
+ * @brief Result of `try_match()`.
+ */
+struct compile_result {
+  match_status status = match_status::ok;        ///< Outcome of the compilation.
+  size_t position = 0;                           ///< Offset of the invalid custom subpattern in the path pattern.
+  std::optional<path_to_regex::matcher> matcher; ///< The compiled matcher if `status` is `match_status::ok`.
+
+  /**
+   * @brief Returns true if the pattern was compiled.
+   */
+  explicit operator bool() const noexcept
+  {
+    return status == match_status::ok;
+  }
+};
+
+/**
+ * @brief Compiles a path pattern into a matcher without throwing.
+ *
+ * Same as `match()`, but an invalid custom subpattern is reported with its position
+ * in the path pattern instead of throwing `std::regex_error`.
+ *
+ * @param path The path pattern.
+ * @param sensitivity The case sensitivity option for matching.
+ *                    Defaults to `case_sensitivity::case_sensitive`.
+ * @return A `compile_result` holding the matcher or the error.
+ *
+ * @see match
+ */
+PATH_TO_REGEX_INLINE compile_result try_match(std::string_view path,
+                                              case_sensitivity sensitivity = case_sensitivity::case_sensitive) noexcept;
+
+/**
+ * @brief Finds the first custom subpattern of a path pattern that does not compile.
+ *
+ * Only the custom subpatterns are compiled, each on its own, so this is cheaper than
+ * `try_match()` when the matcher itself is not needed.
+ *
+ * @param path The path pattern.
+ * @param sensitivity The case sensitivity option for matching.
+ *                    Defaults to `case_sensitivity::case_sensitive`.
+ * @return The offset of the invalid custom subpattern in the path pattern, or nothing
+ *         if every custom subpattern compiles.
+ */
+PATH_TO_REGEX_INLINE std::optional<size_t> find_invalid_subpattern(
+  std::string_view path, case_sensitivity sensitivity = case_sensitivity::case_sensitive);
+
 } // namespace path_to_regex
 
+#if !defined(PATH_TO_REGEX_COMPILED) || defined(PATH_TO_REGEX_IMPLEMENTATION)
+
+namespace path_to_regex {
+namespace details {
+
+struct compiled_regex {
+  std::regex regex;
+};
+
+inline std::regex_constants::syntax_option_type make_regex_flags(path_to_regex::case_sensitivity sensitivity)
+{
+  auto flags = std::regex_constants::ECMAScript;
+  if (sensitivity == path_to_regex::case_sensitivity::case_insensitive) flags |= std::regex_constants::icase;
+  return flags;
+}
+
+PATH_TO_REGEX_INLINE std::string make_pattern(const std::string& path, std::vector<std::string>& keys, char separator)
+{
+  // Regex pattern structure:    | Optional |      Required       | Wildcard |    Special Chars    |
+  static auto rx = std::regex{R"(\{([^}]*)\}|:([\w%]+)(\([^)]+\))?|\*([\w%]+)|([.\^$*+?()|\[\]{}\\]))"};
+  std::sregex_iterator it{path.cbegin(), path.cend(), rx};
+  std::sregex_iterator end;
+  size_t last_pos = 0;
+  std::string pattern;
+
+  constexpr auto optional_param_key_idx = 1;
+  constexpr auto required_param_key_idx = 2;
+  constexpr auto required_param_pattern_idx = 3;
+  constexpr auto wildcard_param_key_idx = 4;
+  constexpr auto special_chars_key_idx = 5;
+
+  for (; it != end; ++it) {
+    auto match = *it;
+
+    if (last_pos < match.position()) pattern += path.substr(last_pos, match.position() - last_pos);
+
+    if (match[optional_param_key_idx].matched) {
+      auto subpattern = make_pattern(match[optional_param_key_idx].str(), keys, separator);
+      if (!subpattern.empty()) pattern += "(?:" + subpattern + ")?";
+    } else if (match[required_param_key_idx].matched) {
+      keys.push_back(percent_decode(match[required_param_key_idx].str()));
+      auto subpattern = match[required_param_pattern_idx].str();
+      if (subpattern.empty()) {
+        pattern += "([^\\";
+        pattern += separator;
+        pattern += "]+?)";
+      } else {
+        pattern += subpattern;
+      }
+    } else if (match[wildcard_param_key_idx].matched) {
+      keys.push_back(percent_decode(match[wildcard_param_key_idx].str()));
+      pattern += "(\\S+?)";
+    } else if (match[special_chars_key_idx].matched) {
+      pattern += '\\';
+      pattern += match[special_chars_key_idx].str();
+    }
+
+    last_pos = match.position() + match.length();
+  }
+
+  if (last_pos < path.length()) pattern += path.substr(last_pos, path.length() - last_pos);
+
+  return pattern;
+}
+
+} // namespace details
+
+PATH_TO_REGEX_INLINE matcher::matcher(std::string pattern, std::vector<std::string> keys, case_sensitivity sensitivity)
+  : m_pattern{std::move(pattern)}
+  , m_regex{std::make_shared<const details::compiled_regex>(
+      details::compiled_regex{std::regex{m_pattern, details::make_regex_flags(sensitivity)}})}
+  , m_keys{std::move(keys)}
+  , m_prefix{details::literal_prefix(m_pattern)}
+  , m_sensitivity{sensitivity}
+{}
+
+PATH_TO_REGEX_INLINE matcher::result matcher::operator()(std::string_view path) const
+{
+  auto encoded_path = details::percent_encode(path);
+
+  std::smatch match;
+  result res = {std::regex_match(encoded_path, match, m_regex->regex)};
+
+  if (res.matched) {
+    for (size_t i = 0; i < m_keys.size(); ++i)
+      res.params[m_keys[i]] = details::percent_decode(match[i + 1].str());
+  }
+
+  return res;
+}
+
+PATH_TO_REGEX_INLINE match_status matcher::try_match(std::string_view path, result& res) const noexcept
+{
+  res.matched = false;
+  res.params.clear();
+
+  try {
+    auto encoded_path = details::percent_encode(path);
+
+    std::smatch match;
+    if (!std::regex_match(encoded_path, match, m_regex->regex)) return match_status::ok;
+
+    for (size_t i = 0; i < m_keys.size(); ++i)
+      res.params[m_keys[i]] = details::percent_decode(match[i + 1].str());
+    res.matched = true;
+    return match_status::ok;
+  } catch (const std::regex_error& e) {
+    res.params.clear();
+    return e.code() == std::regex_constants::error_stack ? match_status::stack : match_status::complexity;
+  } catch (const std::bad_alloc&) {
+    res.params.clear();
+    return match_status::out_of_memory;
+  }
+}
+
+namespace details {
+
+// Finds the first custom subpattern that does not compile on its own.
+inline const token* find_invalid_subpattern(const std::vector<token>& tokens, case_sensitivity sensitivity)
+{
+  for (const auto& t : tokens) {
+    if (t.kind == token_kind::optional) {
+      if (const auto* invalid = find_invalid_subpattern(t.tokens, sensitivity)) return invalid;
+    } else if (t.kind == token_kind::custom_param) {
+      try {
+        std::regex{t.subpattern, make_regex_flags(sensitivity)};
+      } catch (const std::regex_error&) {
+        return &t;
+      }
+    }
+  }
+  return nullptr;
+}
+
+// Returns the offset in `path` of the character at `encoded_offset` in `percent_encode(path)`.
+inline size_t decoded_offset(std::string_view path, size_t encoded_offset)
+{
+  size_t encoded = 0;
+  size_t i = 0;
+  for (; i < path.size() && encoded < encoded_offset; ++i)
+    encoded += needs_percent_encoding(static_cast<unsigned char>(path[i])) ? 3 : 1;
+  return i;
+}
+
+} // namespace details
+
+PATH_TO_REGEX_INLINE compile_result try_match(std::string_view path, case_sensitivity sensitivity) noexcept
+{
+  try {
+    return {match_status::ok, 0, match(path, sensitivity)};
+  } catch (const std::regex_error&) {
+    try {
+      auto position = find_invalid_subpattern(path, sensitivity);
+      return {match_status::invalid_pattern, position.value_or(0), std::nullopt};
+    } catch (const std::bad_alloc&) {
+      return {match_status::invalid_pattern, 0, std::nullopt};
+    }
+  } catch (const std::bad_alloc&) {
+    return {match_status::out_of_memory, 0, std::nullopt};
+  }
+}
+
+PATH_TO_REGEX_INLINE std::optional<size_t> find_invalid_subpattern(std::string_view path, case_sensitivity sensitivity)
+{
+  auto tokens = details::tokenize(details::percent_encode(path));
+  const auto* invalid = details::find_invalid_subpattern(tokens, sensitivity);
+  if (!invalid) return std::nullopt;
+  // The subpattern follows the `:` and the name of its param.
+  return details::decoded_offset(path, invalid->position + 1 + invalid->value.size());
+}
+
+} // namespace path_to_regex
+
+#endif
+
 #endif // PATH_TO_REGEX_H
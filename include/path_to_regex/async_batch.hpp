@@ -0,0 +1,280 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_ASYNC_BATCH_H
+#define PATH_TO_REGEX_ASYNC_BATCH_H
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "<path_to_regex/async_batch.hpp> requires C++20 coroutines"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include <path_to_regex/batch.hpp>
+
+namespace path_to_regex {
+
+/**
+ * @class async_batch_matcher
+ * @brief Matches large batches of paths from C++20 coroutines without blocking their event loop.
+ *
+ * A batch is split into chunks, each matched by a deduplicating `batch_matcher` whose table
+ * and buffers are kept and reused by the following chunks and batches. The batch is awaited with
+ * either `sliced`, which matches on the event loop and yields back to it whenever a time slice
+ * is used up, or `offload`, which matches the chunks on a worker pool. Either way the awaiting
+ * coroutine is resumed through the event loop executor once every path is matched, and an
+ * exception thrown by the matcher is rethrown by `co_await`.
+ *
+ * Executors are callables taking a `std::function<void()>` to run later, such as posting to
+ * an event loop or to a thread pool. One batch can be awaited at a time.
+ *
+ * @tparam Matcher Type with `Matcher::result operator()(std::string_view) const`, e.g. `matcher`.
+ */
+template<typename Matcher = matcher>
+class async_batch_matcher {
+public:
+  using result = typename Matcher::result;
+  using executor = std::function<void(std::function<void()>)>;
+
+  /**
+   * @brief Creates an asynchronous batch matcher.
+   *
+   * @param matcher The matcher to match paths with. Must outlive the batch matcher.
+   * @param loop Executor of the event loop the awaiting coroutines are resumed on.
+   * @param chunk_size Number of paths matched between two checks of the time slice,
+   *                   and per task when offloaded.
+   */
+  async_batch_matcher(const Matcher& matcher, executor loop, size_t chunk_size = 256)
+    : m_matcher{matcher}
+    , m_loop{std::move(loop)}
+    , m_chunk_size{std::max<size_t>(1, chunk_size)}
+  {}
+
+  /**
+   * @brief Returns an awaitable matching a batch on the event loop in time slices.
+   *
+   * The first slice runs when the batch is awaited, and the coroutine continues without
+   * suspending if it is enough. Otherwise every following slice is posted to the event loop.
+   *
+   * @param paths Paths to match. Must stay valid until the batch is matched.
+   * @param results Receives one result per path, in the same order.
+   * @param slice Time after which the matching yields to the event loop.
+   */
+  auto sliced(const std::vector<std::string_view>& paths, std::vector<result>& results,
+              std::chrono::microseconds slice = std::chrono::microseconds{500})
+  {
+    return sliced_awaiter{*this, paths, results, slice};
+  }
+
+  /**
+   * @brief Returns an awaitable matching a batch on a worker pool.
+   *
+   * The chunks are spread over `parallelism` tasks posted to the pool, and the coroutine is
+   * resumed through the event loop once the last task completes.
+   *
+   * @param paths Paths to match. Must stay valid until the batch is matched.
+   * @param results Receives one result per path, in the same order.
+   * @param pool Executor of the worker pool.
+   * @param parallelism Maximum number of tasks matching at the same time.
+   */
+  auto offload(const std::vector<std::string_view>& paths, std::vector<result>& results, executor pool,
+               size_t parallelism)
+  {
+    return offload_awaiter{*this, paths, results, std::move(pool), std::max<size_t>(1, parallelism)};
+  }
+
+private:
+  // Buffers of one chunk at a time, kept across batches.
+  struct scratch {
+    explicit scratch(const Matcher& matcher, size_t chunk_size)
+      : batch{matcher, chunk_size}
+    {}
+
+    batch_matcher<Matcher> batch;
+    std::vector<std::string_view> paths;
+    std::vector<result> results;
+  };
+
+  class sliced_awaiter {
+  public:
+    sliced_awaiter(async_batch_matcher& owner, const std::vector<std::string_view>& paths,
+                   std::vector<result>& results, std::chrono::microseconds slice)
+      : m_owner{owner}
+      , m_paths{paths}
+      , m_results{results}
+      , m_slice{slice}
+    {
+      m_results.resize(m_paths.size());
+    }
+
+    bool await_ready() const noexcept
+    {
+      return m_paths.empty();
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+      m_handle = handle;
+      if (run_slice()) return false;
+      m_owner.m_loop([this] { step(); });
+      return true;
+    }
+
+    void await_resume() const
+    {
+      if (m_error) std::rethrow_exception(m_error);
+    }
+
+  private:
+    void step()
+    {
+      if (run_slice())
+        m_handle.resume();
+      else
+        m_owner.m_loop([this] { step(); });
+    }
+
+    // Returns true once the batch is matched or has failed.
+    bool run_slice()
+    {
+      auto deadline = std::chrono::steady_clock::now() + m_slice;
+      auto& s = m_owner.scratch_at(0);
+      try {
+        while (m_next < m_paths.size()) {
+          auto end = std::min(m_next + m_owner.m_chunk_size, m_paths.size());
+          m_owner.match_chunk(s, m_paths, m_results, m_next, end);
+          m_next = end;
+          if (std::chrono::steady_clock::now() >= deadline) break;
+        }
+      } catch (...) {
+        m_error = std::current_exception();
+        return true;
+      }
+      return m_next == m_paths.size();
+    }
+
+    async_batch_matcher& m_owner;
+    const std::vector<std::string_view>& m_paths;
+    std::vector<result>& m_results;
+    std::chrono::microseconds m_slice;
+    std::coroutine_handle<> m_handle;
+    size_t m_next = 0;
+    std::exception_ptr m_error;
+  };
+
+  class offload_awaiter {
+  public:
+    offload_awaiter(async_batch_matcher& owner, const std::vector<std::string_view>& paths,
+                    std::vector<result>& results, executor pool, size_t parallelism)
+      : m_owner{owner}
+      , m_paths{paths}
+      , m_results{results}
+      , m_pool{std::move(pool)}
+    {
+      m_results.resize(m_paths.size());
+      auto chunks = (m_paths.size() + m_owner.m_chunk_size - 1) / m_owner.m_chunk_size;
+      m_tasks = std::min(parallelism, chunks);
+      for (size_t i = 0; i < m_tasks; ++i)
+        m_owner.scratch_at(i);
+    }
+
+    bool await_ready() const noexcept
+    {
+      return m_paths.empty();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+      m_handle = handle;
+      m_remaining = m_tasks;
+
+      // Once the last task is posted the coroutine may resume and destroy this awaiter,
+      // so the loop only uses copies.
+      auto tasks = m_tasks;
+      auto pool = m_pool;
+      for (size_t i = 0; i < tasks; ++i)
+        pool([this, i] { run_task(i); });
+    }
+
+    void await_resume() const
+    {
+      if (m_error) std::rethrow_exception(m_error);
+    }
+
+  private:
+    // Task `index` matches every `m_tasks`-th chunk with its own scratch buffers.
+    void run_task(size_t index)
+    {
+      auto& s = m_owner.scratch_at(index);
+      try {
+        auto chunk_size = m_owner.m_chunk_size;
+        for (auto begin = index * chunk_size; begin < m_paths.size(); begin += m_tasks * chunk_size)
+          m_owner.match_chunk(s, m_paths, m_results, begin, std::min(begin + chunk_size, m_paths.size()));
+      } catch (...) {
+        std::lock_guard<std::mutex> lock{m_error_mutex};
+        if (!m_error) m_error = std::current_exception();
+      }
+
+      if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) m_owner.m_loop([this] { m_handle.resume(); });
+    }
+
+    async_batch_matcher& m_owner;
+    const std::vector<std::string_view>& m_paths;
+    std::vector<result>& m_results;
+    executor m_pool;
+    size_t m_tasks = 0;
+    std::atomic<size_t> m_remaining{0};
+    std::coroutine_handle<> m_handle;
+    std::mutex m_error_mutex;
+    std::exception_ptr m_error;
+  };
+
+  // Returns the scratch buffers of a task, creating them on first use.
+  // Only called from the awaiting thread before tasks are posted, or with an existing index.
+  scratch& scratch_at(size_t index)
+  {
+    while (m_scratch.size() <= index)
+      m_scratch.push_back(std::make_unique<scratch>(m_matcher, m_chunk_size));
+    return *m_scratch[index];
+  }
+
+  void match_chunk(scratch& s, const std::vector<std::string_view>& paths, std::vector<result>& results,
+                   size_t begin, size_t end)
+  {
+    s.paths.assign(paths.begin() + static_cast<ptrdiff_t>(begin), paths.begin() + static_cast<ptrdiff_t>(end));
+    s.batch(s.paths, s.results);
+    std::move(s.results.begin(), s.results.end(), results.begin() + static_cast<ptrdiff_t>(begin));
+  }
+
+  const Matcher& m_matcher;
+  executor m_loop;
+  size_t m_chunk_size;
+  std::vector<std::unique_ptr<scratch>> m_scratch;
+};
+
+} // namespace path_to_regex
+
+#endif // PATH_TO_REGEX_ASYNC_BATCH_H
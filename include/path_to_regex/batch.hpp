@@ -0,0 +1,140 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_BATCH_H
+#define PATH_TO_REGEX_BATCH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+#include <path_to_regex.hpp>
+
+namespace path_to_regex {
+
+/**
+ * @class batch_matcher
+ * @brief Matches batches of paths, matching every distinct path of a batch once.
+ *
+ * Paths of a batch are hashed into a bounded open-addressing table. The first occurrence of a path
+ * is matched, and its result is copied to the following occurrences. Once `dedup_capacity` distinct
+ * paths have been seen in a batch, the remaining new paths are matched directly. The table is
+ * allocated once and reused across batches.
+ *
+ * @tparam Matcher Type with `Matcher::result operator()(std::string_view) const`, e.g. `matcher`.
+ */
+template<typename Matcher = matcher>
+class batch_matcher {
+public:
+  using result = typename Matcher::result;
+
+  /**
+   * @brief Creates a batch matcher.
+   *
+   * @param matcher The matcher to match paths with. Must outlive the batch matcher.
+   * @param dedup_capacity Maximum number of distinct paths remembered per batch.
+   *                       Zero disables deduplication.
+   */
+  explicit batch_matcher(const Matcher& matcher, size_t dedup_capacity = 1024)
+    : m_matcher{matcher}
+    , m_capacity{dedup_capacity}
+  {
+    if (m_capacity == 0) return;
+
+    size_t slots = 1;
+    while (slots < m_capacity * 2)
+      slots <<= 1;
+    m_slots.resize(slots);
+  }
+
+  /**
+   * @brief Matches a batch of paths.
+   *
+   * @param paths Paths to match.
+   * @param results Receives one result per path, in the same order. Its storage is reused.
+   */
+  void operator()(const std::vector<std::string_view>& paths, std::vector<result>& results)
+  {
+    results.resize(paths.size());
+    m_unique = 0;
+
+    if (m_capacity == 0) {
+      for (size_t i = 0; i < paths.size(); ++i)
+        results[i] = m_matcher(paths[i]);
+      m_unique = paths.size();
+      return;
+    }
+
+    if (++m_generation == 0) {
+      std::fill(m_slots.begin(), m_slots.end(), slot{});
+      m_generation = 1;
+    }
+
+    size_t remembered = 0;
+    const auto mask = m_slots.size() - 1;
+
+    for (size_t i = 0; i < paths.size(); ++i) {
+      auto path = paths[i];
+      auto hash = std::hash<std::string_view>{}(path);
+      auto pos = hash & mask;
+
+      for (;; pos = (pos + 1) & mask) {
+        auto& s = m_slots[pos];
+        if (s.generation != m_generation) {
+          results[i] = m_matcher(path);
+          ++m_unique;
+          if (remembered < m_capacity) {
+            s = {hash, i, m_generation};
+            ++remembered;
+          }
+          break;
+        }
+        if (s.hash == hash && paths[s.index] == path) {
+          results[i] = results[s.index];
+          break;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Returns the number of paths actually matched in the last batch.
+   */
+  size_t unique_count() const
+  {
+    return m_unique;
+  }
+
+private:
+  struct slot {
+    size_t hash = 0;
+    size_t index = 0;
+    uint32_t generation = 0;
+  };
+
+  const Matcher& m_matcher;
+  size_t m_capacity;
+  std::vector<slot> m_slots;
+  uint32_t m_generation = 0;
+  size_t m_unique = 0;
+};
+
+} // namespace path_to_regex
+
+#endif // PATH_TO_REGEX_BATCH_H
@@ -0,0 +1,225 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_CHAIN_H
+#define PATH_TO_REGEX_CHAIN_H
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <path_to_regex.hpp>
+#include <path_to_regex/details/tokenizer.hpp>
+
+namespace path_to_regex {
+
+/**
+ * @enum match_mode
+ * @brief How a chain entry is matched against a path.
+ */
+enum class match_mode {
+  full,   ///< The pattern must match the whole path, like a route.
+  prefix, ///< The pattern must match the path up to a separator, like a mounted middleware.
+};
+
+/**
+ * @struct chain_entry
+ * @brief Definition of a middleware or route to compile into a chain resolver.
+ */
+struct chain_entry {
+  std::string_view pattern;                                        ///< Path pattern of the entry.
+  size_t id = 0;                                                   ///< Handler id reported when the entry matches.
+  match_mode mode = match_mode::full;                              ///< Whether the pattern is matched as a prefix.
+  case_sensitivity sensitivity = case_sensitivity::case_sensitive; ///< Case sensitivity of the entry.
+};
+
+/**
+ * @class chain_resolver
+ * @brief Finds all middlewares and routes of an ordered chain matching a path.
+ *
+ * The literal prefixes of the entries are stored in a trie. A single walk of the path
+ * down the trie selects the precomputed list of entries whose literal prefix the path
+ * starts with, and only these entries are matched. Entries without params are compared
+ * as strings.
+ */
+class chain_resolver {
+public:
+  /**
+   * @struct match
+   * @brief Entry matching a path.
+   */
+  struct match {
+    size_t id = 0;                                       ///< Handler id of the entry.
+    std::unordered_map<std::string, std::string> params; ///< Extracted params from the matched path.
+  };
+
+  chain_resolver() = default;
+
+  /**
+   * @brief Compiles a chain.
+   *
+   * @param entries Middlewares and routes in chain order.
+   *
+   * @throws std::regex_error If an entry has an invalid custom subpattern.
+   */
+  explicit chain_resolver(const std::vector<chain_entry>& entries)
+  {
+    m_entries.reserve(entries.size());
+    for (const auto& e : entries)
+      m_entries.push_back(make_entry(e));
+
+    m_nodes.emplace_back();
+    std::vector<std::vector<size_t>> own(1);
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+      size_t node = 0;
+      for (auto ch : m_entries[i].prefix) {
+        auto folded = details::to_lower_ascii(ch);
+        auto it = std::find_if(m_nodes[node].children.begin(), m_nodes[node].children.end(),
+                               [&](const auto& child) { return child.first == folded; });
+        if (it != m_nodes[node].children.end()) {
+          node = it->second;
+          continue;
+        }
+        m_nodes[node].children.emplace_back(folded, m_nodes.size());
+        node = m_nodes.size();
+        m_nodes.emplace_back();
+        own.emplace_back();
+      }
+      own[node].push_back(i);
+    }
+
+    // Children are always created after their parent, so parents are resolved first.
+    m_lists.emplace_back(own[0]);
+    m_nodes[0].list = 0;
+    for (size_t node = 0; node < m_nodes.size(); ++node) {
+      for (const auto& [ch, child] : m_nodes[node].children) {
+        if (own[child].empty()) {
+          m_nodes[child].list = m_nodes[node].list;
+          continue;
+        }
+        auto list = m_lists[m_nodes[node].list];
+        list.insert(list.end(), own[child].begin(), own[child].end());
+        std::sort(list.begin(), list.end());
+        m_nodes[child].list = m_lists.size();
+        m_lists.push_back(std::move(list));
+      }
+    }
+  }
+
+  /**
+   * @brief Finds all entries matching a path.
+   *
+   * @param path Path to match.
+   * @param matches Receives the matching entries in chain order. Its previous content is discarded.
+   */
+  void operator()(std::string_view path, std::vector<match>& matches) const
+  {
+    matches.clear();
+    if (m_nodes.empty()) return;
+
+    size_t node = 0;
+    for (auto ch : path) {
+      const auto& children = m_nodes[node].children;
+      auto folded = details::to_lower_ascii(ch);
+      auto it =
+        std::find_if(children.begin(), children.end(), [&](const auto& child) { return child.first == folded; });
+      if (it == children.end()) break;
+      node = it->second;
+    }
+
+    // Literals can only be compared with paths that percent encoding leaves unchanged.
+    auto encoded = details::is_percent_encoded(path);
+    for (auto index : m_lists[m_nodes[node].list]) {
+      const auto& e = m_entries[index];
+      auto sensitivity = e.matcher.sensitivity();
+      if (sensitivity == case_sensitivity::case_sensitive && !details::starts_with(path, e.prefix, sensitivity))
+        continue;
+
+      if (e.literal_only && encoded) {
+        if (!details::starts_with(path, e.literal, sensitivity)) continue;
+        auto rest = path.substr(e.literal.size());
+        auto matched =
+          rest.empty() || (rest.front() == e.separator && (e.mode == match_mode::prefix || rest.size() == 1));
+        if (matched) matches.push_back({e.id, {}});
+        continue;
+      }
+
+      auto res = e.matcher(path);
+      if (res.matched) matches.push_back({e.id, std::move(res.params)});
+    }
+  }
+
+  /**
+   * @brief Finds all entries matching a path.
+   *
+   * @param path Path to match.
+   * @return The matching entries in chain order.
+   */
+  std::vector<match> operator()(std::string_view path) const
+  {
+    std::vector<match> matches;
+    (*this)(path, matches);
+    return matches;
+  }
+
+  /**
+   * @brief Returns the number of entries.
+   */
+  size_t size() const
+  {
+    return m_entries.size();
+  }
+
+private:
+  struct entry {
+    path_to_regex::matcher matcher;
+    std::string prefix;
+    size_t id;
+    match_mode mode;
+    bool literal_only;
+    std::string literal;
+    char separator;
+  };
+
+  struct node {
+    std::vector<std::pair<char, size_t>> children;
+    size_t list = 0;
+  };
+
+  static entry make_entry(const chain_entry& e)
+  {
+    auto m = e.mode == match_mode::prefix ? match_prefix(e.pattern, e.sensitivity)
+                                          : path_to_regex::match(e.pattern, e.sensitivity);
+    auto separator = details::find_separator(e.pattern);
+    auto literal = details::pattern_literal(e.pattern, separator);
+    auto literal_only = literal.has_value();
+
+    auto prefix = m.prefix();
+    return {std::move(m), std::move(prefix), e.id, e.mode, literal_only, std::move(literal).value_or(""), separator};
+  }
+
+  std::vector<entry> m_entries;
+  std::vector<node> m_nodes;
+  std::vector<std::vector<size_t>> m_lists;
+};
+
+} // namespace path_to_regex
+
+#endif // PATH_TO_REGEX_CHAIN_H
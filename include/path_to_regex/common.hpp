@@ -0,0 +1,118 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_COMMON_H
+#define PATH_TO_REGEX_COMMON_H
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <string_view>
+
+namespace path_to_regex {
+
+/**
+ * @enum case_sensitivity
+ * @brief Enum class to specify case sensitivity options.
+ *
+ * Indicates whether path comparison should be case-sensitive or case-insensitive.
+ */
+enum class case_sensitivity {
+  case_sensitive,  ///< Path comparison should consider the case of the characters.
+  case_insensitive ///< Path comparison should ignore the case of the characters.
+};
+
+namespace details {
+
+inline bool needs_percent_encoding(unsigned char ch)
+{
+  constexpr std::string_view special_chars = R"(!"#$%&'()*+,-./:;<=>?@[\]^_{|}~`)";
+  return !std::isalnum(ch) && special_chars.find(ch) == std::string_view::npos;
+}
+
+inline std::string percent_encode(std::string_view str)
+{
+  constexpr auto hex_chars = "0123456789ABCDEF";
+
+  std::string encoded;
+  encoded.reserve(str.size() * 3);
+
+  for (unsigned char ch : str) {
+    if (!needs_percent_encoding(ch)) {
+      encoded.push_back(ch);
+    } else {
+      encoded.push_back('%');
+      encoded.push_back(hex_chars[ch >> 4]);
+      encoded.push_back(hex_chars[ch & 0x0F]);
+    }
+  }
+
+  return encoded;
+}
+
+// Returns whether percent encoding leaves `str` unchanged.
+inline bool is_percent_encoded(std::string_view str)
+{
+  return std::none_of(str.begin(), str.end(), [](unsigned char ch) { return needs_percent_encoding(ch); });
+}
+
+inline std::string percent_decode(std::string_view str)
+{
+  std::string decoded;
+  decoded.reserve(str.size());
+
+  for (size_t i = 0; i < str.size();) {
+    if (str[i] == '%' && i + 2 < str.size() && std::isxdigit(str[i + 1]) && std::isxdigit(str[i + 2])) {
+      char ch = 0;
+      for (int j = 1; j < 3; ++j) {
+        ch <<= 4;
+        char hex = str[i + j];
+        ch |= (hex >= '0' && hex <= '9') ? (hex - '0') : (std::toupper(hex) - 'A' + 10);
+      }
+      decoded.push_back(ch);
+      i += 3;
+    } else {
+      decoded.push_back(str[i]);
+      ++i;
+    }
+  }
+
+  return decoded;
+}
+
+inline char find_separator(std::string_view path)
+{
+  return (path.find('/') <= path.find('\\')) ? '/' : '\\';
+}
+
+inline char to_lower_ascii(char ch)
+{
+  return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+}
+
+inline bool starts_with(std::string_view str, std::string_view prefix, path_to_regex::case_sensitivity sensitivity)
+{
+  if (str.size() < prefix.size()) return false;
+  if (sensitivity == path_to_regex::case_sensitivity::case_sensitive) return str.compare(0, prefix.size(), prefix) == 0;
+  return std::equal(prefix.begin(), prefix.end(), str.begin(),
+                    [](char lhs, char rhs) { return to_lower_ascii(lhs) == to_lower_ascii(rhs); });
+}
+
+} // namespace details
+} // namespace path_to_regex
+
+#endif // PATH_TO_REGEX_COMMON_H
@@ -0,0 +1,125 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_DETAILS_TOKENIZER_H
+#define PATH_TO_REGEX_DETAILS_TOKENIZER_H
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <path_to_regex/common.hpp>
+
+namespace path_to_regex {
+namespace details {
+
+enum class token_kind {
+  literal,      ///< Text matched as is.
+  param,        ///< `:name`, matches up to the next separator.
+  custom_param, ///< `:name(subpattern)`, matches a custom regular expression.
+  wildcard,     ///< `*name`, matches across separators.
+  optional      ///< `{...}`, optional group of tokens.
+};
+
+struct token {
+  token_kind kind = token_kind::literal;
+  std::string value;         ///< Literal text, or the (still percent-encoded) name of a param.
+  std::string subpattern;    ///< Custom subpattern of a `custom_param`, including the parentheses.
+  std::vector<token> tokens; ///< Tokens of an `optional` group.
+  size_t position = 0;       ///< Offset of the token in the tokenized text.
+};
+
+inline bool is_name_char(char ch)
+{
+  return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_' || ch == '%';
+}
+
+/**
+ * Splits a percent-encoded path pattern into tokens the same way `make_pattern` does:
+ * optional groups cannot be nested, and `{`, `(`, `:` or `*` that do not start a token
+ * are literal characters. Token positions are offset by `offset`.
+ */
+inline std::vector<token> tokenize(std::string_view path, size_t offset = 0)
+{
+  std::vector<token> tokens;
+
+  auto push_literal = [&](char ch, size_t pos) {
+    if (tokens.empty() || tokens.back().kind != token_kind::literal)
+      tokens.push_back({token_kind::literal, {}, {}, {}, offset + pos});
+    tokens.back().value.push_back(ch);
+  };
+
+  for (size_t i = 0; i < path.size();) {
+    auto ch = path[i];
+
+    if (ch == '{') {
+      auto close = path.find('}', i + 1);
+      if (close != std::string_view::npos) {
+        auto group = tokenize(path.substr(i + 1, close - i - 1), offset + i + 1);
+        if (!group.empty()) tokens.push_back({token_kind::optional, {}, {}, std::move(group), offset + i});
+        i = close + 1;
+        continue;
+      }
+    } else if ((ch == ':' || ch == '*') && i + 1 < path.size() && is_name_char(path[i + 1])) {
+      auto end = i + 1;
+      while (end < path.size() && is_name_char(path[end]))
+        ++end;
+
+      token t{ch == ':' ? token_kind::param : token_kind::wildcard, std::string{path.substr(i + 1, end - i - 1)}, {}, {},
+              offset + i};
+      if (ch == ':' && end + 2 < path.size() && path[end] == '(' && path[end + 1] != ')') {
+        auto close = path.find(')', end + 1);
+        if (close != std::string_view::npos) {
+          t.kind = token_kind::custom_param;
+          t.subpattern = std::string{path.substr(end, close - end + 1)};
+          end = close + 1;
+        }
+      }
+
+      tokens.push_back(std::move(t));
+      i = end;
+      continue;
+    }
+
+    push_literal(ch, i);
+    ++i;
+  }
+
+  return tokens;
+}
+
+/**
+ * Returns the percent-encoded literal of a pattern without params, without its trailing
+ * separator, or nothing if the pattern has params. The literal can be compared as is
+ * with the paths for which `is_percent_encoded` is true.
+ */
+inline std::optional<std::string> pattern_literal(std::string_view pattern, char separator)
+{
+  auto tokens = tokenize(percent_encode(pattern));
+  if (tokens.empty()) return std::string{};
+  if (tokens.size() != 1 || tokens.front().kind != token_kind::literal) return std::nullopt;
+
+  auto literal = std::move(tokens.front().value);
+  if (literal.back() == separator) literal.pop_back();
+  return literal;
+}
+
+} // namespace details
+} // namespace path_to_regex
+
+#endif // PATH_TO_REGEX_DETAILS_TOKENIZER_H
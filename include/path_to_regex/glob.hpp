@@ -0,0 +1,454 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_GLOB_H
+#define PATH_TO_REGEX_GLOB_H
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "<path_to_regex/glob.hpp> requires a POSIX system"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+#include <path_to_regex/common.hpp>
+#include <path_to_regex/details/tokenizer.hpp>
+#include <path_to_regex/native.hpp>
+
+namespace path_to_regex {
+namespace details {
+
+class unique_fd {
+public:
+  explicit unique_fd(int fd)
+    : m_fd{fd}
+  {}
+
+  unique_fd(const unique_fd&) = delete;
+  unique_fd& operator=(const unique_fd&) = delete;
+
+  ~unique_fd()
+  {
+    if (m_fd >= 0) ::close(m_fd);
+  }
+
+  int get() const
+  {
+    return m_fd;
+  }
+
+  int release()
+  {
+    return std::exchange(m_fd, -1);
+  }
+
+private:
+  int m_fd;
+};
+
+/**
+ * Calls `f(name, is_directory)` for every entry of an open directory but `.` and `..`.
+ * Entries are read in large blocks with `getdents64` on Linux, and their type is taken
+ * from the directory entry unless the file system does not report it.
+ */
+template<typename F>
+void for_each_dir_entry(int fd, std::vector<char>& buffer, F&& f)
+{
+  auto is_directory = [fd](const char* name, unsigned char type) {
+    if (type != DT_UNKNOWN) return type == DT_DIR;
+    struct stat st {};
+    return ::fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode);
+  };
+
+  auto dot = [](const char* name) { return name[0] == '.' && (!name[1] || (name[1] == '.' && !name[2])); };
+
+#if defined(__linux__)
+  struct linux_dirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+  };
+
+  for (;;) {
+    auto size = ::syscall(SYS_getdents64, fd, buffer.data(), buffer.size());
+    if (size <= 0) break;
+    for (long pos = 0; pos < size;) {
+      auto entry = reinterpret_cast<const linux_dirent64*>(buffer.data() + pos);
+      pos += entry->d_reclen;
+      if (!dot(entry->d_name)) f(std::string_view{entry->d_name}, is_directory(entry->d_name, entry->d_type));
+    }
+  }
+#else
+  (void)buffer;
+  // The stream owns a duplicate, the caller still closes its descriptor.
+  auto dup_fd = ::dup(fd);
+  auto dir = dup_fd < 0 ? nullptr : ::fdopendir(dup_fd);
+  if (!dir) {
+    if (dup_fd >= 0) ::close(dup_fd);
+    return;
+  }
+  while (auto entry = ::readdir(dir)) {
+    if (!dot(entry->d_name)) f(std::string_view{entry->d_name}, is_directory(entry->d_name, entry->d_type));
+  }
+  ::closedir(dir);
+#endif
+}
+
+/**
+ * Per-thread deques of pending directories. A thread pushes and pops its own directories
+ * at the back, depth first, and steals the oldest, largest subtrees of the other threads
+ * from the front once its deque is empty. Threads finding no task sleep until another
+ * thread pushes one, every task is done or the queue is stopped.
+ */
+template<typename Task>
+class work_stealing_queue {
+public:
+  explicit work_stealing_queue(size_t threads)
+    : m_deques{std::make_unique<deque[]>(threads)}
+    , m_size{threads}
+  {}
+
+  void push(size_t self, Task task)
+  {
+    m_pending.fetch_add(1);
+    {
+      std::lock_guard<std::mutex> lock{m_deques[self].mutex};
+      m_deques[self].tasks.push_back(std::move(task));
+    }
+
+    m_pushes.fetch_add(1);
+    if (m_sleepers.load() != 0) {
+      std::lock_guard<std::mutex> lock{m_idle_mutex};
+      m_idle.notify_all();
+    }
+  }
+
+  // Pops a task, waiting while other threads may still push some.
+  // Returns false once every task is done or the queue is stopped.
+  bool pop(size_t self, Task& task)
+  {
+    for (;;) {
+      auto pushes = m_pushes.load();
+      if (m_stopped.load()) return false;
+      if (try_pop(self, task)) return true;
+
+      std::unique_lock<std::mutex> lock{m_idle_mutex};
+      m_sleepers.fetch_add(1);
+      m_idle.wait(lock, [&] { return m_stopped || m_pending.load() == 0 || m_pushes.load() != pushes; });
+      m_sleepers.fetch_sub(1);
+      if (m_stopped || m_pending.load() == 0) return false;
+    }
+  }
+
+  // Marks a popped task as done, after the tasks it pushed.
+  void done()
+  {
+    if (m_pending.fetch_sub(1) == 1) {
+      std::lock_guard<std::mutex> lock{m_idle_mutex};
+      m_idle.notify_all();
+    }
+  }
+
+  // Makes every thread stop popping tasks.
+  void stop()
+  {
+    std::lock_guard<std::mutex> lock{m_idle_mutex};
+    m_stopped.store(true);
+    m_idle.notify_all();
+  }
+
+private:
+  struct alignas(64) deque {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  bool try_pop(size_t self, Task& task)
+  {
+    {
+      std::lock_guard<std::mutex> lock{m_deques[self].mutex};
+      if (!m_deques[self].tasks.empty()) {
+        task = std::move(m_deques[self].tasks.back());
+        m_deques[self].tasks.pop_back();
+        return true;
+      }
+    }
+
+    for (size_t i = 1; i < m_size; ++i) {
+      auto& victim = m_deques[(self + i) % m_size];
+      std::lock_guard<std::mutex> lock{victim.mutex};
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  std::unique_ptr<deque[]> m_deques;
+  size_t m_size;
+  std::atomic<size_t> m_pending{0};
+  std::atomic<size_t> m_pushes{0};
+  std::atomic<size_t> m_sleepers{0};
+  std::mutex m_idle_mutex;
+  std::condition_variable m_idle;
+  std::atomic<bool> m_stopped{false};
+};
+
+} // namespace details
+
+/**
+ * @class glob_walker
+ * @brief Selects the files and directories of a tree whose path matches a pattern.
+ *
+ * Paths are matched relative to the root of the walk, starting with a separator, e.g.
+ * `/src/main.cpp`, with the separator of the pattern. The walker only descends into
+ * directories whose path agrees with the literal leading text of the pattern, e.g.
+ * `/src/` for `/src/:dir/:file`, and, unless the pattern has a wildcard, that are not
+ * deeper than the number of separators of the pattern.
+ *
+ * Directories are read on several threads sharing a work-stealing queue. Each one is
+ * opened by name relative to its parent with `openat`, the parent being kept open while
+ * its subdirectories are queued, so the depth of the tree is not limited by `PATH_MAX`.
+ * Symbolic links are matched but never followed,
+ * and directories that cannot be opened are skipped.
+ */
+class glob_walker {
+public:
+  /**
+   * @struct entry
+   * @brief A file or directory matching the pattern.
+   */
+  struct entry {
+    std::string path;                                    ///< Path relative to the root.
+    std::unordered_map<std::string, std::string> params; ///< Params extracted from the path.
+    bool directory = false;                              ///< True if the entry is a directory.
+  };
+
+  /**
+   * @brief Compiles the pattern of a walker.
+   *
+   * @param pattern The path pattern, matched with the native engine.
+   * @param sensitivity The case sensitivity option for matching.
+   * @param threads Number of threads reading directories, including the calling thread.
+   *
+   * @throws std::invalid_argument If the pattern has a custom `(...)` subpattern.
+   */
+  explicit glob_walker(std::string_view pattern, case_sensitivity sensitivity = case_sensitivity::case_sensitive,
+                       size_t threads = std::thread::hardware_concurrency())
+    : m_matcher{native::match(pattern, sensitivity)}
+    , m_separator{details::find_separator(pattern)}
+    , m_sensitivity{sensitivity}
+    , m_threads{std::max<size_t>(1, threads)}
+  {
+    auto tokens = details::tokenize(details::percent_encode(pattern));
+
+    // A trailing separator is optional, as for the matcher.
+    if (!tokens.empty() && tokens.back().kind == details::token_kind::literal &&
+        tokens.back().value.back() == m_separator) {
+      tokens.back().value.pop_back();
+      if (tokens.back().value.empty()) tokens.pop_back();
+    }
+
+    if (!tokens.empty() && tokens.front().kind == details::token_kind::literal) m_prefix = tokens.front().value;
+    m_max_depth = max_depth(tokens);
+  }
+
+  /**
+   * @brief Walks a tree and calls `on_match(entry&&)` for every matching entry.
+   *
+   * Matches are streamed as they are found, in no particular order, from the walking
+   * threads but one call at a time. An exception thrown by `on_match` stops the walk
+   * and is rethrown.
+   *
+   * @param root Directory to walk.
+   * @param on_match Callable receiving the matching entries.
+   * @return The number of directories read, the root included.
+   *
+   * @throws std::system_error If the root cannot be opened.
+   */
+  template<typename F>
+  size_t operator()(const std::string& root, F&& on_match) const
+  {
+    auto root_fd = std::make_shared<const details::unique_fd>(::open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (root_fd->get() < 0) throw std::system_error{errno, std::generic_category(), "cannot open '" + root + "'"};
+
+    walk_state<F> state{on_match, m_threads};
+    state.queue.push(0, {std::move(root_fd), ".", {}, 0});
+
+    std::vector<std::thread> threads;
+    try {
+      for (size_t i = 1; i < m_threads; ++i)
+        threads.emplace_back([this, &state, i] { work(state, i); });
+    } catch (...) {
+      state.fail(std::current_exception());
+    }
+
+    work(state, 0);
+    for (auto& t : threads)
+      t.join();
+
+    if (state.error) std::rethrow_exception(state.error);
+    return state.directories.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct directory {
+    std::shared_ptr<const details::unique_fd> parent; ///< Open parent directory, kept while queued.
+    std::string name;                                 ///< Name in the parent directory for `openat`.
+    std::string path;                                 ///< Path relative to the root with the separator of the pattern.
+    size_t depth = 0;
+  };
+
+  template<typename F>
+  struct walk_state {
+    walk_state(F& f, size_t threads)
+      : on_match{f}
+      , queue{threads}
+    {}
+
+    void fail(std::exception_ptr e)
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      if (!error) error = std::move(e);
+      stopped.store(true, std::memory_order_relaxed);
+      queue.stop();
+    }
+
+    F& on_match;
+    details::work_stealing_queue<directory> queue;
+    std::mutex mutex; ///< Serializes `on_match` and guards `error`.
+    std::exception_ptr error;
+    std::atomic<bool> stopped{false};
+    std::atomic<size_t> directories{0};
+  };
+
+  static constexpr size_t unbounded = static_cast<size_t>(-1);
+  static constexpr size_t buffer_size = 64 << 10;
+
+  // Number of separators a matching path can have, params stopping at separators.
+  size_t max_depth(const std::vector<details::token>& tokens) const
+  {
+    size_t depth = 0;
+    for (const auto& t : tokens) {
+      if (t.kind == details::token_kind::wildcard) return unbounded;
+      if (t.kind == details::token_kind::literal)
+        depth += static_cast<size_t>(std::count(t.value.begin(), t.value.end(), m_separator));
+      if (t.kind == details::token_kind::optional) {
+        auto group = max_depth(t.tokens);
+        if (group == unbounded) return unbounded;
+        depth += group;
+      }
+    }
+    return depth;
+  }
+
+  // Whether a path below the directory can still match the pattern.
+  bool may_descend(const std::string& path, size_t depth) const
+  {
+    if (m_max_depth != unbounded && depth >= m_max_depth) return false;
+    if (m_prefix.empty()) return true;
+
+    auto encoded = details::percent_encode(path);
+    encoded.push_back(m_separator);
+    return encoded.size() < m_prefix.size() ? details::starts_with(m_prefix, encoded, m_sensitivity)
+                                            : details::starts_with(encoded, m_prefix, m_sensitivity);
+  }
+
+  template<typename F>
+  void work(walk_state<F>& state, size_t self) const
+  {
+    std::vector<char> buffer(buffer_size);
+    directory dir;
+
+    try {
+      while (state.queue.pop(self, dir)) {
+        visit(state, self, dir, buffer);
+        dir.parent.reset();
+        state.queue.done();
+      }
+    } catch (...) {
+      state.fail(std::current_exception());
+    }
+  }
+
+  template<typename F>
+  void visit(walk_state<F>& state, size_t self, const directory& dir, std::vector<char>& buffer) const
+  {
+    auto fd = ::openat(dir.parent->get(), dir.name.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) return;
+    auto self_fd = std::make_shared<const details::unique_fd>(fd);
+    state.directories.fetch_add(1, std::memory_order_relaxed);
+
+    details::for_each_dir_entry(fd, buffer, [&](std::string_view name, bool is_directory) {
+      if (state.stopped.load(std::memory_order_relaxed)) return;
+
+      auto path = dir.path;
+      path.push_back(m_separator);
+      path.append(name);
+
+      auto res = m_matcher(path);
+      if (res.matched) {
+        std::lock_guard<std::mutex> lock{state.mutex};
+        if (state.stopped.load(std::memory_order_relaxed)) return;
+        state.on_match(entry{path, std::move(res.params), is_directory});
+      }
+
+      if (is_directory && may_descend(path, dir.depth + 1))
+        state.queue.push(self, {self_fd, std::string{name}, std::move(path), dir.depth + 1});
+    });
+  }
+
+  native::matcher m_matcher;
+  char m_separator;
+  case_sensitivity m_sensitivity;
+  size_t m_threads;
+  std::string m_prefix;
+  size_t m_max_depth = unbounded;
+};
+
+} // namespace path_to_regex
+
+#endif // PATH_TO_REGEX_GLOB_H
@@ -0,0 +1,211 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_NATIVE_H
+#define PATH_TO_REGEX_NATIVE_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <path_to_regex/common.hpp>
+#include <path_to_regex/details/tokenizer.hpp>
+
+namespace path_to_regex {
+namespace native {
+
+/**
+ * @class matcher
+ * @brief Matches paths against a pattern without regular expressions.
+ *
+ * Matches exactly the same paths and extracts the same params as `path_to_regex::matcher`
+ * with a backtracking matcher over the pattern tokens, so that including this header
+ * does not pull in `<regex>`. Patterns with custom `(...)` subpatterns are not supported.
+ */
+class matcher {
+public:
+  /**
+   * @struct result
+   * @brief Result of a path match operation.
+   *
+   * Indicates whether the path matched and contains extracted params if matched.
+   */
+  struct result {
+    bool matched = false;                                ///< True if the path matched the pattern.
+    std::unordered_map<std::string, std::string> params; ///< Extracted params from the matched path.
+  };
+
+  /**
+   * @brief Matches a path against the pattern.
+   *
+   * @param path Path to match.
+   * @return A `result` indicating match status and params.
+   */
+  result operator()(std::string_view path) const
+  {
+    // Paths without characters to encode, the common case, are matched in place.
+    std::string encoded_path;
+    if (std::any_of(path.begin(), path.end(), [](unsigned char ch) { return details::needs_percent_encoding(ch); })) {
+      encoded_path = details::percent_encode(path);
+      path = encoded_path;
+    }
+
+    // Captures are kept on the stack unless the pattern has many keys,
+    // so that only the params of a match allocate.
+    std::string_view inline_captures[max_inline_captures];
+    std::vector<std::string_view> heap_captures;
+    auto captures = inline_captures;
+    if (m_keys.size() > max_inline_captures) {
+      heap_captures.resize(m_keys.size());
+      captures = heap_captures.data();
+    }
+
+    result res{match_step(path, 0, 0, captures), {}};
+    if (res.matched) {
+      for (size_t i = 0; i < m_keys.size(); ++i)
+        res.params[m_keys[i]] = details::percent_decode(captures[i]);
+    }
+
+    return res;
+  }
+
+  /**
+   * @brief Returns the case sensitivity of the matcher.
+   */
+  case_sensitivity sensitivity() const
+  {
+    return m_sensitivity;
+  }
+
+private:
+  friend matcher match(std::string_view path, case_sensitivity sensitivity);
+
+  static constexpr size_t max_inline_captures = 8;
+
+  enum class step_kind { literal, param, wildcard, optional_begin, optional_end };
+
+  struct step {
+    step_kind kind;
+    std::string literal;
+    size_t key = 0;     ///< Capture index of a param or wildcard.
+    size_t skip_to = 0; ///< Step following the group of an `optional_begin`.
+  };
+
+  matcher(std::string_view path, case_sensitivity sensitivity)
+    : m_separator{details::find_separator(path)}
+    , m_sensitivity{sensitivity}
+  {
+    auto tokens = details::tokenize(details::percent_encode(path));
+
+    // A trailing separator is optional, as if it were not part of the pattern.
+    if (!tokens.empty() && tokens.back().kind == details::token_kind::literal &&
+        tokens.back().value.back() == m_separator) {
+      tokens.back().value.pop_back();
+      if (tokens.back().value.empty()) tokens.pop_back();
+    }
+
+    add_steps(tokens);
+  }
+
+  void add_steps(const std::vector<details::token>& tokens)
+  {
+    for (const auto& t : tokens) {
+      switch (t.kind) {
+      case details::token_kind::literal:
+        m_steps.push_back({step_kind::literal, t.value, 0, 0});
+        break;
+      case details::token_kind::param:
+      case details::token_kind::wildcard:
+        m_steps.push_back({t.kind == details::token_kind::param ? step_kind::param : step_kind::wildcard, {},
+                           m_keys.size(), 0});
+        m_keys.push_back(details::percent_decode(t.value));
+        break;
+      case details::token_kind::custom_param:
+        throw std::invalid_argument{"custom subpattern " + t.subpattern + " requires the regex engine"};
+      case details::token_kind::optional: {
+        auto begin = m_steps.size();
+        m_steps.push_back({step_kind::optional_begin, {}, 0, 0});
+        add_steps(t.tokens);
+        m_steps.push_back({step_kind::optional_end, {}, 0, 0});
+        m_steps[begin].skip_to = m_steps.size();
+        break;
+      }
+      }
+    }
+  }
+
+  // Backtracks in the order of the equivalent regular expression: params and wildcards
+  // are lazy and optional groups are greedy, so the same params are extracted.
+  bool match_step(std::string_view path, size_t index, size_t pos, std::string_view* captures) const
+  {
+    if (index == m_steps.size()) return pos == path.size() || (pos + 1 == path.size() && path[pos] == m_separator);
+
+    const auto& s = m_steps[index];
+    switch (s.kind) {
+    case step_kind::literal: {
+      if (!details::starts_with(path.substr(pos), s.literal, m_sensitivity)) return false;
+      return match_step(path, index + 1, pos + s.literal.size(), captures);
+    }
+    case step_kind::param:
+    case step_kind::wildcard:
+      for (auto end = pos + 1; end <= path.size(); ++end) {
+        if (s.kind == step_kind::param && path[end - 1] == m_separator) break;
+        captures[s.key] = path.substr(pos, end - pos);
+        if (match_step(path, index + 1, end, captures)) return true;
+      }
+      captures[s.key] = {};
+      return false;
+    case step_kind::optional_begin:
+      return match_step(path, index + 1, pos, captures) || match_step(path, s.skip_to, pos, captures);
+    case step_kind::optional_end:
+      break;
+    }
+
+    return match_step(path, index + 1, pos, captures);
+  }
+
+  char m_separator;
+  case_sensitivity m_sensitivity;
+  std::vector<step> m_steps;
+  std::vector<std::string> m_keys;
+};
+
+/**
+ * @brief Compiles a path pattern into a native matcher.
+ *
+ * @param path The path pattern.
+ * @param sensitivity The case sensitivity option for matching.
+ *                    Defaults to `case_sensitivity::case_sensitive`.
+ * @return A `native::matcher` object.
+ *
+ * @throws std::invalid_argument If the pattern has a custom `(...)` subpattern.
+ *
+ * @see matcher
+ */
+inline matcher match(std::string_view path, case_sensitivity sensitivity = case_sensitivity::case_sensitive)
+{
+  return {path, sensitivity};
+}
+
+} // namespace native
+} // namespace path_to_regex
+
+#endif // PATH_TO_REGEX_NATIVE_H
@@ -0,0 +1,201 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_OVERLAY_H
+#define PATH_TO_REGEX_OVERLAY_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <path_to_regex/router.hpp>
+
+namespace path_to_regex {
+
+/**
+ * @class overlay_router
+ * @brief Per-tenant route tables sharing one immutable base router.
+ *
+ * Every tenant has a small overlay router that is tried before the shared base router.
+ * Tenant tables never copy the base, so adding or removing a tenant costs only
+ * the compilation of its overlay. Overlays are immutable and can themselves be
+ * shared by several tenants.
+ *
+ * Const member functions can be called concurrently; modifications need external
+ * synchronization.
+ */
+class overlay_router {
+public:
+  /**
+   * @class table
+   * @brief Route table of one tenant: its overlay followed by the base.
+   *
+   * Shares the overlay and the base it was created with, so it stays valid and
+   * unchanged when the tenant or the base of the overlay router are replaced.
+   */
+  class table {
+  public:
+    /**
+     * @brief Finds the first route matching a path, in the overlay first and then in the base.
+     */
+    router::result operator()(std::string_view path) const
+    {
+      return route(m_overlay.get(), *m_base, path);
+    }
+
+  private:
+    friend class overlay_router;
+
+    table(std::shared_ptr<const router> overlay, std::shared_ptr<const router> base)
+      : m_overlay{std::move(overlay)}
+      , m_base{std::move(base)}
+    {}
+
+    std::shared_ptr<const router> m_overlay;
+    std::shared_ptr<const router> m_base;
+  };
+
+  /**
+   * @brief Creates an overlay router without tenants.
+   *
+   * @param base Routes shared by all tenants.
+   *
+   * @throws std::invalid_argument If the base is null.
+   */
+  explicit overlay_router(std::shared_ptr<const router> base)
+    : m_base{std::move(base)}
+  {
+    if (!m_base) throw std::invalid_argument{"overlay_router base must not be null"};
+  }
+
+  /**
+   * @brief Adds or replaces a tenant, compiling its overlay routes.
+   *
+   * @param tenant Tenant name.
+   * @param routes Tenant routes, tried before the base routes.
+   *
+   * @throws std::regex_error If a route has an invalid custom subpattern.
+   */
+  void add_tenant(std::string_view tenant, const std::vector<route>& routes)
+  {
+    add_tenant(tenant, routes.empty() ? nullptr : std::make_shared<const router>(routes));
+  }
+
+  /**
+   * @brief Adds or replaces a tenant with an already compiled overlay.
+   *
+   * @param tenant Tenant name.
+   * @param overlay Tenant routes, possibly shared with other tenants. May be null.
+   */
+  void add_tenant(std::string_view tenant, std::shared_ptr<const router> overlay)
+  {
+    auto it = m_tenants.find(tenant);
+    if (it == m_tenants.end())
+      m_tenants.emplace(std::string{tenant}, std::move(overlay));
+    else
+      it->second = std::move(overlay);
+  }
+
+  /**
+   * @brief Removes a tenant.
+   *
+   * @return True if the tenant existed.
+   */
+  bool remove_tenant(std::string_view tenant)
+  {
+    auto it = m_tenants.find(tenant);
+    if (it == m_tenants.end()) return false;
+    m_tenants.erase(it);
+    return true;
+  }
+
+  /**
+   * @brief Replaces the base routes of all tenants at once.
+   *
+   * Tables returned before keep the previous base.
+   *
+   * @throws std::invalid_argument If the base is null.
+   */
+  void set_base(std::shared_ptr<const router> base)
+  {
+    if (!base) throw std::invalid_argument{"overlay_router base must not be null"};
+    m_base = std::move(base);
+  }
+
+  /**
+   * @brief Returns the route table of a tenant.
+   *
+   * Unknown tenants get the base routes only.
+   */
+  table tenant(std::string_view tenant) const
+  {
+    auto it = m_tenants.find(tenant);
+    return {it == m_tenants.end() ? nullptr : it->second, m_base};
+  }
+
+  /**
+   * @brief Finds the first route matching a path in the table of a tenant.
+   *
+   * @param tenant Tenant name. Unknown tenants get the base routes only.
+   * @param path Path to match.
+   * @return A `router::result` with the handler id and params of the matched route.
+   */
+  router::result operator()(std::string_view tenant, std::string_view path) const
+  {
+    // Routes without copying the shared pointers of a table.
+    auto it = m_tenants.find(tenant);
+    return route(it == m_tenants.end() ? nullptr : it->second.get(), *m_base, path);
+  }
+
+  /**
+   * @brief Returns the base routes.
+   */
+  const std::shared_ptr<const router>& base() const
+  {
+    return m_base;
+  }
+
+  /**
+   * @brief Returns the number of tenants.
+   */
+  size_t size() const
+  {
+    return m_tenants.size();
+  }
+
+private:
+  static router::result route(const router* overlay, const router& base, std::string_view path)
+  {
+    if (overlay) {
+      auto res = (*overlay)(path);
+      if (res.matched) return res;
+    }
+    return base(path);
+  }
+
+  std::shared_ptr<const router> m_base;
+  std::map<std::string, std::shared_ptr<const router>, std::less<>> m_tenants;
+};
+
+} // namespace path_to_regex
+
+#endif // PATH_TO_REGEX_OVERLAY_H
@@ -0,0 +1,166 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_ROUTE_FILE_H
+#define PATH_TO_REGEX_ROUTE_FILE_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <path_to_regex/router.hpp>
+
+namespace path_to_regex {
+
+/**
+ * @struct route_file_error
+ * @brief Error found while parsing a route file.
+ */
+struct route_file_error {
+  size_t line = 0;     ///< One-based line number.
+  size_t column = 0;   ///< One-based column number.
+  std::string message; ///< Description of the error.
+};
+
+/**
+ * @struct route_file
+ * @brief Routes parsed from a route file.
+ *
+ * Route patterns are views into the parsed text, which must outlive the routes.
+ */
+struct route_file {
+  std::vector<route> routes;            ///< Routes in file order.
+  std::vector<size_t> lines;            ///< Line number of every route.
+  std::vector<route_file_error> errors; ///< All errors found in the file.
+
+  /**
+   * @brief Returns true if the file has no errors.
+   */
+  bool ok() const
+  {
+    return errors.empty();
+  }
+};
+
+namespace details {
+
+inline std::string_view next_field(std::string_view line, size_t& pos)
+{
+  while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t'))
+    ++pos;
+  auto begin = pos;
+  while (pos < line.size() && line[pos] != ' ' && line[pos] != '\t')
+    ++pos;
+  return line.substr(begin, pos - begin);
+}
+
+inline const char* check_braces(std::string_view pattern, size_t& pos)
+{
+  size_t open = std::string_view::npos;
+  for (pos = 0; pos < pattern.size(); ++pos) {
+    if (pattern[pos] == '{') {
+      if (open != std::string_view::npos) return "nested '{' is not supported";
+      open = pos;
+    } else if (pattern[pos] == '}') {
+      if (open == std::string_view::npos) return "unmatched '}'";
+      open = std::string_view::npos;
+    }
+  }
+  pos = open;
+  return open == std::string_view::npos ? nullptr : "unmatched '{'";
+}
+
+} // namespace details
+
+/**
+ * @brief Parses a route file.
+ *
+ * Every non-empty line that does not start with `#` defines a route:
+ *
+ *     PATTERN [id=N] [case_sensitive|case_insensitive]
+ *
+ * Fields are separated by spaces or tabs. If `id` is omitted, the route gets the number
+ * of routes defined before it as its id. Custom subpatterns that do not compile are
+ * reported as errors. Parsing does not stop at the first error, so all errors of the file
+ * are reported at once.
+ *
+ * @param text Contents of the route file.
+ * @return The parsed routes and errors.
+ */
+inline route_file parse_route_file(std::string_view text)
+{
+  route_file file;
+  file.routes.reserve(static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) + 1);
+
+  auto error = [&](size_t line, size_t column, std::string message) {
+    file.errors.push_back({line, column + 1, std::move(message)});
+  };
+
+  for (size_t line_number = 1; !text.empty(); ++line_number) {
+    auto newline = static_cast<const char*>(std::memchr(text.data(), '\n', text.size()));
+    auto length = newline ? static_cast<size_t>(newline - text.data()) : text.size();
+    auto line = text.substr(0, length);
+    text.remove_prefix(newline ? length + 1 : length);
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+    size_t pos = 0;
+    auto pattern_begin = line.find_first_not_of(" \t");
+    auto pattern = details::next_field(line, pos);
+    if (pattern.empty() || pattern.front() == '#') continue;
+
+    route r{pattern, file.routes.size()};
+    size_t brace_pos = 0;
+    if (auto message = details::check_braces(pattern, brace_pos))
+      error(line_number, pattern_begin + brace_pos, message);
+
+    for (auto field = details::next_field(line, pos); !field.empty(); field = details::next_field(line, pos)) {
+      auto column = pos - field.size();
+      if (field.front() == '#') break;
+
+      if (field == "case_sensitive") {
+        r.sensitivity = case_sensitivity::case_sensitive;
+      } else if (field == "case_insensitive") {
+        r.sensitivity = case_sensitivity::case_insensitive;
+      } else if (field.substr(0, 3) == "id=") {
+        auto value = field.substr(3);
+        auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), r.id);
+        if (ec != std::errc{} || end != value.data() + value.size() || value.empty())
+          error(line_number, column + 3, "invalid id '" + std::string{value} + "'");
+      } else {
+        error(line_number, column, "unknown option '" + std::string{field} + "'");
+      }
+    }
+
+    // Only the custom subpatterns are compiled here, the router compiles the whole pattern.
+    if (pattern.find('(') != std::string_view::npos) {
+      if (auto position = find_invalid_subpattern(pattern, r.sensitivity))
+        error(line_number, pattern_begin + *position, "invalid custom subpattern");
+    }
+
+    file.routes.push_back(r);
+    file.lines.push_back(line_number);
+  }
+
+  return file;
+}
+
+} // namespace path_to_regex
+
+#endif // PATH_TO_REGEX_ROUTE_FILE_H
@@ -0,0 +1,399 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_ROUTER_H
+#define PATH_TO_REGEX_ROUTER_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <path_to_regex.hpp>
+#include <path_to_regex/details/tokenizer.hpp>
+
+namespace path_to_regex {
+
+/**
+ * @struct route
+ * @brief Definition of a route to compile into a router.
+ */
+struct route {
+  std::string_view pattern;                                        ///< Path pattern of the route.
+  size_t id = 0;                                                   ///< Handler id reported when the route matches.
+  case_sensitivity sensitivity = case_sensitivity::case_sensitive; ///< Case sensitivity of the route.
+};
+
+/**
+ * @class route_profile
+ * @brief Number of hits of every route id, used to optimize a router for its traffic.
+ *
+ * Profiles are recorded with `router::operator()(path, profile)`, merged across threads
+ * with `merge()` and stored as text with one `ID HITS` pair per line.
+ */
+class route_profile {
+public:
+  /**
+   * @brief Adds hits to a route id.
+   */
+  void add(size_t id, uint64_t hits = 1)
+  {
+    m_hits[id] += hits;
+  }
+
+  /**
+   * @brief Returns the number of hits of a route id.
+   */
+  uint64_t hits(size_t id) const
+  {
+    auto it = m_hits.find(id);
+    return it == m_hits.end() ? 0 : it->second;
+  }
+
+  /**
+   * @brief Adds the hits of another profile.
+   */
+  void merge(const route_profile& other)
+  {
+    for (const auto& [id, hits] : other.m_hits)
+      m_hits[id] += hits;
+  }
+
+  /**
+   * @brief Writes the profile as text, one `ID HITS` pair per line in id order.
+   */
+  void write(std::ostream& out) const
+  {
+    std::vector<std::pair<size_t, uint64_t>> hits{m_hits.begin(), m_hits.end()};
+    std::sort(hits.begin(), hits.end());
+    for (const auto& [id, count] : hits)
+      out << id << ' ' << count << '\n';
+  }
+
+  /**
+   * @brief Parses a profile written by `write()`.
+   *
+   * Empty lines and lines starting with `#` are ignored.
+   *
+   * @param text Profile text.
+   * @return The parsed profile.
+   *
+   * @throws std::invalid_argument If a line is not an `ID HITS` pair.
+   */
+  static route_profile parse(std::string_view text)
+  {
+    route_profile profile;
+
+    for (size_t line_number = 1; !text.empty(); ++line_number) {
+      auto newline = text.find('\n');
+      auto line = text.substr(0, newline);
+      text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+
+      auto begin = line.find_first_not_of(" \t\r");
+      if (begin == std::string_view::npos || line[begin] == '#') continue;
+
+      const auto* first = line.data() + begin;
+      const auto* last = line.data() + line.size();
+      size_t id = 0;
+      uint64_t hits = 0;
+      auto id_end = std::from_chars(first, last, id);
+      auto hits_begin = id_end.ptr;
+      while (hits_begin != last && (*hits_begin == ' ' || *hits_begin == '\t'))
+        ++hits_begin;
+      auto hits_end = std::from_chars(hits_begin, last, hits);
+      auto rest = std::string_view{hits_end.ptr, static_cast<size_t>(last - hits_end.ptr)};
+
+      if (id_end.ec != std::errc{} || hits_begin == id_end.ptr || hits_end.ec != std::errc{} ||
+          rest.find_first_not_of(" \t\r") != std::string_view::npos)
+        throw std::invalid_argument{"invalid route profile line " + std::to_string(line_number)};
+
+      profile.add(id, hits);
+    }
+
+    return profile;
+  }
+
+private:
+  std::unordered_map<size_t, uint64_t> m_hits;
+};
+
+/**
+ * @class router
+ * @brief Matches paths against an ordered set of routes.
+ *
+ * Routes are tried in the order they were added and the first matching one wins.
+ * A route is only matched against its regular expression if the path starts with
+ * the route's literal prefix, and routes without params are compared as strings.
+ *
+ * `optimize()` reorganizes the router for a recorded traffic profile: the hottest routes
+ * are tried first, and the rest stay in a secondary list in route order.
+ */
+class router {
+public:
+  /**
+   * @struct result
+   * @brief Result of a routing operation.
+   */
+  struct result {
+    bool matched = false;                                ///< True if a route matched the path.
+    size_t id = 0;                                       ///< Handler id of the matched route.
+    std::unordered_map<std::string, std::string> params; ///< Extracted params from the matched path.
+  };
+
+  router() = default;
+
+  /**
+   * @brief Compiles a set of routes.
+   *
+   * @param routes Routes in priority order.
+   * @param threads Number of threads used to compile the routes.
+   *
+   * @throws std::regex_error If a route has an invalid custom subpattern.
+   */
+  explicit router(const std::vector<route>& routes, size_t threads = 1)
+    : router{compile(routes, threads)}
+  {}
+
+  /**
+   * @brief Adds a route with the lowest priority.
+   *
+   * @param r Route to add.
+   *
+   * @throws std::regex_error If the route has an invalid custom subpattern.
+   */
+  void add(const route& r)
+  {
+    m_routes.push_back(make_entry(r));
+    m_cold.push_back(m_routes.size() - 1);
+  }
+
+  /**
+   * @brief Finds the first route matching a path.
+   *
+   * @param path Path to match.
+   * @return A `result` with the handler id and params of the matched route.
+   */
+  result operator()(std::string_view path) const
+  {
+    for (const auto& hot : m_hot) {
+      auto res = match_entry(*m_routes[hot.index], path);
+      if (!res.matched) continue;
+
+      for (auto index : hot.conflicts) {
+        auto earlier = match_entry(*m_routes[index], path);
+        if (earlier.matched) return earlier;
+      }
+      return res;
+    }
+
+    for (auto index : m_cold) {
+      auto res = match_entry(*m_routes[index], path);
+      if (res.matched) return res;
+    }
+
+    return {};
+  }
+
+  /**
+   * @brief Finds the first route matching a path and records the hit in a profile.
+   *
+   * @param path Path to match.
+   * @param profile Profile receiving the hit. Use one profile per thread and merge them.
+   * @return A `result` with the handler id and params of the matched route.
+   */
+  result operator()(std::string_view path, route_profile& profile) const
+  {
+    auto res = (*this)(path);
+    if (res.matched) profile.add(res.id);
+    return res;
+  }
+
+  /**
+   * @brief Reorganizes the router for a traffic profile.
+   *
+   * The routes receiving `hot_share` of the hits, but no more than `max_hot_routes` routes,
+   * are tried first in order of decreasing hits. When a hot route matches, only the earlier
+   * routes whose literal prefix is compatible with its own are checked to preserve the
+   * first-match order. The other routes are tried afterwards in route order.
+   *
+   * @param profile Hits per route id.
+   * @param hot_share Share of the hits to serve from hot routes.
+   * @param max_hot_routes Maximum number of hot routes.
+   */
+  void optimize(const route_profile& profile, double hot_share = 0.9, size_t max_hot_routes = 64)
+  {
+    std::vector<std::pair<uint64_t, size_t>> hits;
+    uint64_t total = 0;
+    for (size_t i = 0; i < m_routes.size(); ++i) {
+      hits.emplace_back(profile.hits(m_routes[i]->id), i);
+      total += hits.back().first;
+    }
+    std::stable_sort(hits.begin(), hits.end(), [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    m_hot.clear();
+    std::vector<bool> is_hot(m_routes.size());
+    uint64_t served = 0;
+    for (const auto& [count, index] : hits) {
+      if (count == 0 || m_hot.size() == max_hot_routes || served >= hot_share * total) break;
+
+      hot_route hot{index, {}};
+      for (size_t i = 0; i < index; ++i) {
+        if (!is_hot[i] && compatible_prefixes(m_routes[i]->prefix, m_routes[index]->prefix))
+          hot.conflicts.push_back(i);
+      }
+      m_hot.push_back(std::move(hot));
+      is_hot[index] = true;
+      served += count;
+    }
+
+    m_cold.clear();
+    for (size_t i = 0; i < m_routes.size(); ++i)
+      if (!is_hot[i]) m_cold.push_back(i);
+  }
+
+  /**
+   * @brief Returns the number of routes.
+   */
+  size_t size() const
+  {
+    return m_routes.size();
+  }
+
+private:
+  friend class route_snapshots;
+
+  struct entry {
+    std::string pattern;
+    path_to_regex::matcher matcher;
+    std::string prefix;
+    size_t id;
+    bool literal_only;
+    std::string literal;
+    char separator;
+  };
+
+  struct hot_route {
+    size_t index;
+    std::vector<size_t> conflicts;
+  };
+
+  using entry_ptr = std::shared_ptr<const entry>;
+
+  explicit router(std::vector<entry_ptr> routes)
+    : m_routes{std::move(routes)}
+    , m_cold(m_routes.size())
+  {
+    for (size_t i = 0; i < m_cold.size(); ++i)
+      m_cold[i] = i;
+  }
+
+  static std::vector<entry_ptr> compile(const std::vector<route>& routes, size_t threads)
+  {
+    threads = std::max<size_t>(1, std::min(threads, routes.size()));
+    auto step = (routes.size() + threads - 1) / std::max<size_t>(1, threads);
+    std::vector<std::vector<entry_ptr>> parts(threads);
+
+    auto compile_part = [&](size_t part) {
+      auto first = std::min(part * step, routes.size());
+      auto last = std::min(first + step, routes.size());
+      parts[part].reserve(last - first);
+      for (auto i = first; i < last; ++i)
+        parts[part].push_back(make_entry(routes[i]));
+    };
+
+    if (threads == 1) {
+      compile_part(0);
+    } else {
+      std::vector<std::thread> workers;
+      std::vector<std::exception_ptr> errors(threads);
+      for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+          try {
+            compile_part(t);
+          } catch (...) {
+            errors[t] = std::current_exception();
+          }
+        });
+      }
+      for (auto& worker : workers)
+        worker.join();
+      for (const auto& error : errors)
+        if (error) std::rethrow_exception(error);
+    }
+
+    std::vector<entry_ptr> entries;
+    entries.reserve(routes.size());
+    for (auto& part : parts)
+      std::move(part.begin(), part.end(), std::back_inserter(entries));
+    return entries;
+  }
+
+  static entry_ptr make_entry(const route& r)
+  {
+    auto m = match(r.pattern, r.sensitivity);
+    auto separator = details::find_separator(r.pattern);
+    auto literal = details::pattern_literal(r.pattern, separator);
+    auto literal_only = literal.has_value();
+
+    auto prefix = m.prefix();
+    return std::make_shared<const entry>(entry{std::string{r.pattern}, std::move(m), std::move(prefix), r.id,
+                                               literal_only, std::move(literal).value_or(""), separator});
+  }
+
+  // Two routes can only match the same path if the literal prefix of one starts with the other.
+  static bool compatible_prefixes(std::string_view lhs, std::string_view rhs)
+  {
+    if (lhs.size() > rhs.size()) std::swap(lhs, rhs);
+    return details::starts_with(rhs, lhs, case_sensitivity::case_insensitive);
+  }
+
+  static result match_entry(const entry& e, std::string_view path)
+  {
+    auto sensitivity = e.matcher.sensitivity();
+    if (!details::starts_with(path, e.prefix, sensitivity)) return {};
+
+    // A route without params matches its literal, optionally followed by a separator.
+    if (e.literal_only && details::is_percent_encoded(path)) {
+      if (!details::starts_with(path, e.literal, sensitivity)) return {};
+      auto rest = path.substr(e.literal.size());
+      if (rest.empty() || (rest.size() == 1 && rest.front() == e.separator)) return {true, e.id, {}};
+      return {};
+    }
+
+    auto res = e.matcher(path);
+    if (!res.matched) return {};
+    return {true, e.id, std::move(res.params)};
+  }
+
+  std::vector<entry_ptr> m_routes;
+  std::vector<hot_route> m_hot;
+  std::vector<size_t> m_cold;
+};
+
+} // namespace path_to_regex
+
+#endif // PATH_TO_REGEX_ROUTER_H
@@ -0,0 +1,298 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_SNAPSHOTS_H
+#define PATH_TO_REGEX_SNAPSHOTS_H
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <path_to_regex/router.hpp>
+
+namespace path_to_regex {
+
+/**
+ * @struct route_change
+ * @brief Route added or removed between two snapshots.
+ */
+struct route_change {
+  std::string pattern;                                             ///< Path pattern of the route.
+  size_t id = 0;                                                   ///< Handler id of the route.
+  case_sensitivity sensitivity = case_sensitivity::case_sensitive; ///< Case sensitivity of the route.
+};
+
+/**
+ * @struct route_diff
+ * @brief Differences between two snapshots.
+ *
+ * A route whose id or case sensitivity changed is reported as removed and added.
+ */
+struct route_diff {
+  std::vector<route_change> added;   ///< Routes of the newer snapshot missing from the older one, in route order.
+  std::vector<route_change> removed; ///< Routes of the older snapshot missing from the newer one, in route order.
+  bool reordered = false;            ///< True if routes present in both snapshots changed their relative order.
+
+  /**
+   * @brief Returns true if both snapshots have the same routes in the same order.
+   */
+  bool empty() const
+  {
+    return added.empty() && removed.empty() && !reordered;
+  }
+};
+
+/**
+ * @class route_snapshots
+ * @brief Keeps the last compiled versions of a route table for instant rollback.
+ *
+ * Every published version is an immutable router. Routes unchanged since a retained
+ * version reuse its compiled entries, so only changed routes are compiled and the
+ * memory of a retained version is one pointer per route plus its changed routes.
+ *
+ * `current()` can be called concurrently with `publish()` and `rollback()`; readers keep
+ * the router they loaded alive for as long as they hold it.
+ */
+class route_snapshots {
+public:
+  /**
+   * @brief Creates an empty history.
+   *
+   * @param retained Number of versions kept for rollback, at least one.
+   */
+  explicit route_snapshots(size_t retained = 8)
+    : m_retained{std::max<size_t>(1, retained)}
+  {}
+
+  /**
+   * @brief Compiles a new version of the route table and makes it current.
+   *
+   * The oldest version is dropped if more than the retained number of versions are kept.
+   *
+   * @param routes Routes in priority order.
+   * @param threads Number of threads used to compile the changed routes.
+   * @return Number of the new version, starting from 1.
+   *
+   * @throws std::regex_error If a route has an invalid custom subpattern. The current version is kept.
+   */
+  size_t publish(const std::vector<route>& routes, size_t threads = 1)
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    std::map<key, router::entry_ptr> compiled;
+    for (const auto& v : m_versions)
+      for (const auto& e : v.table->m_routes)
+        compiled.emplace(make_key(*e), e);
+
+    std::vector<router::entry_ptr> entries(routes.size());
+    std::vector<route> changed;
+    std::vector<size_t> changed_index;
+    for (size_t i = 0; i < routes.size(); ++i) {
+      auto it = compiled.find(key{routes[i].pattern, routes[i].id, routes[i].sensitivity});
+      if (it != compiled.end()) {
+        entries[i] = it->second;
+      } else {
+        changed.push_back(routes[i]);
+        changed_index.push_back(i);
+      }
+    }
+
+    auto fresh = router::compile(changed, threads);
+    for (size_t i = 0; i < fresh.size(); ++i)
+      entries[changed_index[i]] = std::move(fresh[i]);
+
+    auto table = std::shared_ptr<const router>{new router{std::move(entries)}};
+    m_versions.push_back({++m_last_version, table});
+    if (m_versions.size() > m_retained) m_versions.pop_front();
+    store_current(std::move(table));
+    m_current_version = m_last_version;
+    return m_last_version;
+  }
+
+  /**
+   * @brief Returns the current version of the route table, or null before the first `publish()`.
+   */
+  std::shared_ptr<const router> current() const
+  {
+#if defined(__cpp_lib_atomic_shared_ptr)
+    return m_current.load();
+#else
+    return std::atomic_load(&m_current);
+#endif
+  }
+
+  /**
+   * @brief Returns the number of the current version, or 0 before the first `publish()`.
+   */
+  size_t current_version() const
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_current_version;
+  }
+
+  /**
+   * @brief Returns the numbers of the retained versions, oldest first.
+   */
+  std::vector<size_t> versions() const
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    std::vector<size_t> numbers;
+    for (const auto& v : m_versions)
+      numbers.push_back(v.number);
+    return numbers;
+  }
+
+  /**
+   * @brief Returns a retained version of the route table.
+   *
+   * @throws std::out_of_range If the version is not retained.
+   */
+  std::shared_ptr<const router> get(size_t version) const
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return find(version).table;
+  }
+
+  /**
+   * @brief Makes the retained version preceding the current one current without recompiling.
+   *
+   * @return False if no older version is retained.
+   */
+  bool rollback()
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto it = std::find_if(m_versions.rbegin(), m_versions.rend(),
+                           [&](const version& v) { return v.number < m_current_version; });
+    if (it == m_versions.rend()) return false;
+    store_current(it->table);
+    m_current_version = it->number;
+    return true;
+  }
+
+  /**
+   * @brief Makes a retained version current without recompiling.
+   *
+   * @throws std::out_of_range If the version is not retained.
+   */
+  void rollback(size_t version)
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    store_current(find(version).table);
+    m_current_version = version;
+  }
+
+  /**
+   * @brief Reports the routes changed between two retained versions.
+   *
+   * @param from Older version.
+   * @param to Newer version.
+   *
+   * @throws std::out_of_range If a version is not retained.
+   */
+  route_diff diff(size_t from, size_t to) const
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    const auto& before = find(from).table->m_routes;
+    const auto& after = find(to).table->m_routes;
+
+    auto index = [](const std::vector<router::entry_ptr>& routes) {
+      std::map<key, size_t> positions;
+      for (size_t i = 0; i < routes.size(); ++i)
+        positions.emplace(make_key(*routes[i]), i);
+      return positions;
+    };
+    auto before_index = index(before);
+    auto after_index = index(after);
+
+    route_diff result;
+    for (const auto& e : before)
+      if (!after_index.count(make_key(*e))) result.removed.push_back(make_change(*e));
+
+    size_t last_position = 0;
+    bool first = true;
+    for (const auto& e : after) {
+      auto it = before_index.find(make_key(*e));
+      if (it == before_index.end()) {
+        result.added.push_back(make_change(*e));
+        continue;
+      }
+      if (!first && it->second < last_position) result.reordered = true;
+      last_position = it->second;
+      first = false;
+    }
+
+    return result;
+  }
+
+private:
+  using key = std::tuple<std::string_view, size_t, case_sensitivity>;
+
+  struct version {
+    size_t number;
+    std::shared_ptr<const router> table;
+  };
+
+  static key make_key(const router::entry& e)
+  {
+    return {e.pattern, e.id, e.matcher.sensitivity()};
+  }
+
+  static route_change make_change(const router::entry& e)
+  {
+    return {e.pattern, e.id, e.matcher.sensitivity()};
+  }
+
+  // The free atomic functions for shared_ptr are deprecated in C++20 in favor of std::atomic<std::shared_ptr>.
+  void store_current(std::shared_ptr<const router> table)
+  {
+#if defined(__cpp_lib_atomic_shared_ptr)
+    m_current.store(std::move(table));
+#else
+    std::atomic_store(&m_current, std::move(table));
+#endif
+  }
+
+  const version& find(size_t number) const
+  {
+    for (const auto& v : m_versions)
+      if (v.number == number) return v;
+    throw std::out_of_range{"route table version " + std::to_string(number) + " is not retained"};
+  }
+
+  size_t m_retained;
+  size_t m_last_version = 0;
+  size_t m_current_version = 0;
+  std::deque<version> m_versions;
+#if defined(__cpp_lib_atomic_shared_ptr)
+  std::atomic<std::shared_ptr<const router>> m_current;
+#else
+  std::shared_ptr<const router> m_current;
+#endif
+  mutable std::mutex m_mutex;
+};
+
+} // namespace path_to_regex
+
+#endif // PATH_TO_REGEX_SNAPSHOTS_H
@@ -0,0 +1,75 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+module;
+
+#include <path_to_regex.hpp>
+#include <path_to_regex/batch.hpp>
+#include <path_to_regex/chain.hpp>
+#include <path_to_regex/native.hpp>
+#include <path_to_regex/overlay.hpp>
+#include <path_to_regex/route_file.hpp>
+#include <path_to_regex/router.hpp>
+#include <path_to_regex/snapshots.hpp>
+
+export module path_to_regex;
+
+export namespace path_to_regex {
+
+// path_to_regex.hpp
+using path_to_regex::case_sensitivity;
+using path_to_regex::compile_result;
+using path_to_regex::find_invalid_subpattern;
+using path_to_regex::match;
+using path_to_regex::match_prefix;
+using path_to_regex::match_status;
+using path_to_regex::matcher;
+using path_to_regex::try_match;
+
+// path_to_regex/batch.hpp
+using path_to_regex::batch_matcher;
+
+// path_to_regex/chain.hpp
+using path_to_regex::chain_entry;
+using path_to_regex::chain_resolver;
+using path_to_regex::match_mode;
+
+// path_to_regex/overlay.hpp
+using path_to_regex::overlay_router;
+
+// path_to_regex/route_file.hpp
+using path_to_regex::parse_route_file;
+using path_to_regex::route_file;
+using path_to_regex::route_file_error;
+
+// path_to_regex/router.hpp
+using path_to_regex::route;
+using path_to_regex::route_profile;
+using path_to_regex::router;
+
+// path_to_regex/snapshots.hpp
+using path_to_regex::route_change;
+using path_to_regex::route_diff;
+using path_to_regex::route_snapshots;
+
+namespace native {
+// path_to_regex/native.hpp
+using path_to_regex::native::match;
+using path_to_regex::native::matcher;
+} // namespace native
+
+} // namespace path_to_regex
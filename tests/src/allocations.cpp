@@ -0,0 +1,225 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <path_to_regex/batch.hpp>
+#include <path_to_regex/chain.hpp>
+#include <path_to_regex/native.hpp>
+#include <path_to_regex/router.hpp>
+#include <path_to_regex.hpp>
+
+// Global operator new is replaced to count the allocations made while counting is on.
+// The library allocates only through operator new, directly or through standard containers.
+namespace {
+
+std::atomic<bool> counting{false};
+std::atomic<size_t> allocations{0};
+
+void* allocate(std::size_t size)
+{
+  if (counting.load(std::memory_order_relaxed)) allocations.fetch_add(1, std::memory_order_relaxed);
+  if (auto* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+  throw std::bad_alloc{};
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+  return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+  return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace {
+
+// Returns the number of allocations made by `f`. Its result is kept alive until counting stops.
+template<typename F>
+size_t allocations_of(F&& f)
+{
+  allocations = 0;
+  counting = true;
+  [[maybe_unused]] auto result = f();
+  counting = false;
+  return allocations.load();
+}
+
+// Exact counts depend on the bucket growth of `std::unordered_map` and the small string capacity
+// of the standard library, so they are only checked with libstdc++. Other libraries only have to
+// keep misses free and allocate for params.
+#if defined(__GLIBCXX__)
+constexpr bool exact_counts = true;
+#else
+constexpr bool exact_counts = false;
+#endif
+
+// The MSVC standard library allocates for a default-constructed `std::unordered_map`,
+// so a result without params is not free there.
+#if defined(_MSVC_STL_VERSION)
+constexpr bool empty_params_allocate = true;
+#else
+constexpr bool empty_params_allocate = false;
+#endif
+
+TEST(Allocations, CountsAllocations)
+{
+  EXPECT_EQ(allocations_of([] { return std::string(64, 'x').size(); }), 1);
+  EXPECT_EQ(allocations_of([] { return std::make_unique<int[]>(4) != nullptr; }), 1);
+}
+
+TEST(Allocations, NativeMissDoesNotAllocate)
+{
+  if (empty_params_allocate) GTEST_SKIP() << "Empty params allocate with this standard library";
+  auto matcher = path_to_regex::native::match("/users/:id/files/*path");
+
+  EXPECT_EQ(allocations_of([&] { return matcher("/users/42"); }), 0);
+  EXPECT_EQ(allocations_of([&] { return matcher("/posts/42/files/a.txt"); }), 0);
+  EXPECT_EQ(allocations_of([&] { return matcher("/users//files/a.txt"); }), 0);
+}
+
+TEST(Allocations, NativeMatchAllocatesOnlyParams)
+{
+  auto matcher = path_to_regex::native::match("/users/:id/files/*path");
+
+  auto count = allocations_of([&] { return matcher("/users/42/files/a/b.txt"); });
+  EXPECT_NE(count, 0);
+  // A params map allocates one node per param and, once not empty, one bucket array.
+  // These params and keys fit in the small string buffer, so they do not allocate.
+  if (exact_counts) {
+    EXPECT_EQ(count, 3);
+  }
+
+  if (empty_params_allocate) return;
+  auto literal = path_to_regex::native::match("/status");
+  EXPECT_EQ(allocations_of([&] { return literal("/status/"); }), 0);
+}
+
+TEST(Allocations, NativeManyKeys)
+{
+  auto matcher = path_to_regex::native::match("/:a/:b/:c/:d/:e/:f/:g/:h/:i");
+
+  auto miss = allocations_of([&] { return matcher("/1/2/3/4/5/6/7/8"); });
+  auto match = allocations_of([&] { return matcher("/1/2/3/4/5/6/7/8/9"); });
+  EXPECT_NE(match, 0);
+  if (exact_counts) {
+    // Beyond the inline captures one buffer is allocated per call.
+    EXPECT_EQ(miss, 1);
+    // The captures, nine nodes and the buckets.
+    EXPECT_EQ(match, 11);
+  }
+}
+
+TEST(Allocations, RouterLiteralRoute)
+{
+  if (empty_params_allocate) GTEST_SKIP() << "Empty params allocate with this standard library";
+
+  path_to_regex::router router{{{"/api/v1/status", 1}, {"/users/:id", 2}}};
+
+  EXPECT_EQ(allocations_of([&] { return router("/api/v1/status"); }), 0);
+  EXPECT_EQ(allocations_of([&] { return router("/api/v1/status/"); }), 0);
+  EXPECT_EQ(allocations_of([&] { return router("/posts/42"); }), 0);
+}
+
+TEST(Allocations, ChainLiteralEntries)
+{
+  if (empty_params_allocate) GTEST_SKIP() << "Empty params allocate with this standard library";
+
+  path_to_regex::chain_resolver chain{{
+    {"/", 1, path_to_regex::match_mode::prefix},
+    {"/api", 2, path_to_regex::match_mode::prefix},
+    {"/api/v1/status", 3},
+  }};
+
+  // The matches vector is reused, so resolving again does not allocate.
+  std::vector<path_to_regex::chain_resolver::match> matches;
+  chain("/api/v1/status", matches);
+  EXPECT_EQ(allocations_of([&] {
+              chain("/api/v1/status", matches);
+              return matches.size();
+            }),
+            0);
+  EXPECT_EQ(matches.size(), 3);
+}
+
+TEST(Allocations, BatchReusesTable)
+{
+  if (empty_params_allocate) GTEST_SKIP() << "Empty params allocate with this standard library";
+
+  auto matcher = path_to_regex::native::match("/users/:id");
+  path_to_regex::batch_matcher<path_to_regex::native::matcher> batch{matcher, 16};
+
+  std::vector<std::string_view> paths{"/posts/1", "/posts/2", "/posts/1", "/posts/3"};
+  std::vector<path_to_regex::native::matcher::result> results;
+  batch(paths, results);
+
+  // Batches of misses reuse the table and the results storage.
+  EXPECT_EQ(allocations_of([&] {
+              batch(paths, results);
+              return results.size();
+            }),
+            0);
+}
+
+TEST(Allocations, RegexMatch)
+{
+  auto matcher = path_to_regex::match("/users/:id");
+  path_to_regex::matcher::result res;
+
+  auto call = allocations_of([&] { return matcher("/users/42"); });
+  auto reused = allocations_of([&] { return matcher.try_match("/users/42", res); });
+  EXPECT_NE(call, 0);
+  EXPECT_NE(reused, 0);
+  // The regex engine allocates its match state on every call, even into a reused result.
+  // The counts are recorded to catch regressions.
+  if (exact_counts) {
+    EXPECT_EQ(call, 6);
+    EXPECT_EQ(reused, 6);
+  }
+}
+
+} // namespace
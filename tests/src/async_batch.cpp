@@ -0,0 +1,284 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <path_to_regex/async_batch.hpp>
+#include <path_to_regex/native.hpp>
+
+namespace {
+
+// Fire-and-forget coroutine running until its first suspension when called.
+struct task {
+  struct promise_type {
+    task get_return_object()
+    {
+      return {};
+    }
+    std::suspend_never initial_suspend() noexcept
+    {
+      return {};
+    }
+    std::suspend_never final_suspend() noexcept
+    {
+      return {};
+    }
+    void return_void() {}
+    void unhandled_exception()
+    {
+      std::terminate();
+    }
+  };
+};
+
+// Single-threaded event loop running posted callbacks in order.
+class event_loop {
+public:
+  void post(std::function<void()> f)
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_queue.push_back(std::move(f));
+    m_cv.notify_one();
+  }
+
+  // Runs callbacks until `done` is set, returns the number of callbacks run.
+  size_t run(const bool& done)
+  {
+    size_t count = 0;
+    while (!done) {
+      std::unique_lock<std::mutex> lock{m_mutex};
+      m_cv.wait(lock, [&] { return !m_queue.empty(); });
+      auto f = std::move(m_queue.front());
+      m_queue.pop_front();
+      lock.unlock();
+      f();
+      ++count;
+    }
+    return count;
+  }
+
+  path_to_regex::async_batch_matcher<>::executor executor()
+  {
+    return [this](std::function<void()> f) { post(std::move(f)); };
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::function<void()>> m_queue;
+};
+
+// Worker pool running every posted callback on its own thread.
+class thread_pool {
+public:
+  ~thread_pool()
+  {
+    for (auto& t : m_threads)
+      t.join();
+  }
+
+  path_to_regex::async_batch_matcher<>::executor executor()
+  {
+    return [this](std::function<void()> f) { m_threads.emplace_back(std::move(f)); };
+  }
+
+private:
+  std::vector<std::thread> m_threads;
+};
+
+std::vector<std::string> make_paths(size_t count)
+{
+  std::vector<std::string> paths;
+  for (size_t i = 0; i < count; ++i)
+    paths.push_back(i % 3 ? "/users/" + std::to_string(i % 500) : "/posts/" + std::to_string(i));
+  return paths;
+}
+
+void expect_results(const path_to_regex::matcher& matcher, const std::vector<std::string_view>& paths,
+                    const std::vector<path_to_regex::matcher::result>& results)
+{
+  ASSERT_EQ(results.size(), paths.size());
+  for (size_t i = 0; i < paths.size(); ++i) {
+    auto expected = matcher(paths[i]);
+    EXPECT_EQ(results[i].matched, expected.matched) << paths[i];
+    EXPECT_EQ(results[i].params, expected.params) << paths[i];
+  }
+}
+
+TEST(AsyncBatch, SlicedYieldsToEventLoop)
+{
+  auto storage = make_paths(5000);
+  std::vector<std::string_view> paths{storage.begin(), storage.end()};
+  auto matcher = path_to_regex::match("/users/:id");
+
+  event_loop loop;
+  path_to_regex::async_batch_matcher batch{matcher, loop.executor(), 64};
+  std::vector<path_to_regex::matcher::result> results;
+  auto done = false;
+
+  // The closure must outlive the coroutine, which refers to its captures.
+  auto coroutine = [&]() -> task {
+    co_await batch.sliced(paths, results, std::chrono::microseconds{0});
+    done = true;
+  };
+  coroutine();
+
+  EXPECT_FALSE(done);
+  EXPECT_EQ(loop.run(done), (paths.size() + 63) / 64 - 1);
+  expect_results(matcher, paths, results);
+}
+
+TEST(AsyncBatch, SlicedCompletesWithoutSuspendingWithinSlice)
+{
+  std::vector<std::string_view> paths{"/users/1", "/posts/1", "/users/1"};
+  auto matcher = path_to_regex::match("/users/:id");
+
+  event_loop loop;
+  path_to_regex::async_batch_matcher batch{matcher, loop.executor()};
+  std::vector<path_to_regex::matcher::result> results;
+  auto done = false;
+
+  auto coroutine = [&]() -> task {
+    co_await batch.sliced(paths, results, std::chrono::seconds{10});
+    done = true;
+  };
+  coroutine();
+
+  EXPECT_TRUE(done);
+  expect_results(matcher, paths, results);
+}
+
+TEST(AsyncBatch, OffloadResumesOnEventLoop)
+{
+  auto storage = make_paths(5000);
+  std::vector<std::string_view> paths{storage.begin(), storage.end()};
+  auto matcher = path_to_regex::match("/users/:id");
+
+  event_loop loop;
+  path_to_regex::async_batch_matcher batch{matcher, loop.executor(), 128};
+  std::vector<path_to_regex::matcher::result> results;
+  auto done = false;
+  std::thread::id resumed_on;
+
+  for (int round = 0; round < 2; ++round) {
+    thread_pool pool;
+    done = false;
+    auto coroutine = [&]() -> task {
+      co_await batch.offload(paths, results, pool.executor(), 4);
+      resumed_on = std::this_thread::get_id();
+      done = true;
+    };
+    coroutine();
+
+    loop.run(done);
+    EXPECT_EQ(resumed_on, std::this_thread::get_id());
+    expect_results(matcher, paths, results);
+  }
+}
+
+TEST(AsyncBatch, OffloadWithInlineExecutors)
+{
+  auto storage = make_paths(1000);
+  std::vector<std::string_view> paths{storage.begin(), storage.end()};
+  auto matcher = path_to_regex::match("/users/:id");
+
+  // The last task resumes the coroutine, which completes and destroys the awaiter,
+  // before the awaiter is done posting the tasks.
+  auto run_inline = [](std::function<void()> f) { f(); };
+  path_to_regex::async_batch_matcher batch{matcher, run_inline, 100};
+  std::vector<path_to_regex::matcher::result> results;
+  auto done = false;
+
+  auto coroutine = [&]() -> task {
+    co_await batch.offload(paths, results, run_inline, 4);
+    done = true;
+  };
+  coroutine();
+
+  EXPECT_TRUE(done);
+  expect_results(matcher, paths, results);
+}
+
+TEST(AsyncBatch, EmptyBatch)
+{
+  auto matcher = path_to_regex::match("/users/:id");
+  event_loop loop;
+  path_to_regex::async_batch_matcher batch{matcher, loop.executor()};
+  std::vector<path_to_regex::matcher::result> results(3);
+  auto done = false;
+
+  auto coroutine = [&]() -> task {
+    co_await batch.sliced({}, results);
+    done = true;
+  };
+  coroutine();
+
+  EXPECT_TRUE(done);
+  EXPECT_TRUE(results.empty());
+}
+
+struct throwing_matcher {
+  using result = path_to_regex::native::matcher::result;
+
+  result operator()(std::string_view path) const
+  {
+    if (path == "/bad") throw std::runtime_error{"bad path"};
+    return {true, {}};
+  }
+};
+
+TEST(AsyncBatch, RethrowsMatcherExceptions)
+{
+  std::vector<std::string_view> paths{"/a", "/b", "/bad", "/c"};
+  throwing_matcher matcher;
+
+  event_loop loop;
+  path_to_regex::async_batch_matcher<throwing_matcher> batch{matcher, loop.executor(), 1};
+  std::vector<throwing_matcher::result> results;
+  auto done = false;
+  auto sliced_threw = false;
+  auto offload_threw = false;
+
+  auto coroutine = [&]() -> task {
+    try {
+      co_await batch.sliced(paths, results, std::chrono::microseconds{0});
+    } catch (const std::runtime_error&) {
+      sliced_threw = true;
+    }
+
+    thread_pool pool;
+    auto pool_executor = [&](std::function<void()> f) { pool.executor()(std::move(f)); };
+    try {
+      co_await batch.offload(paths, results, pool_executor, 2);
+    } catch (const std::runtime_error&) {
+      offload_threw = true;
+    }
+    done = true;
+  };
+  coroutine();
+
+  loop.run(done);
+  EXPECT_TRUE(sliced_threw);
+  EXPECT_TRUE(offload_threw);
+}
+
+} // namespace
@@ -0,0 +1,100 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <path_to_regex/batch.hpp>
+
+#include "corpus.hpp"
+
+namespace {
+
+using params_type = std::unordered_map<std::string, std::string>;
+
+TEST(Batch, FansOutResultsToDuplicates)
+{
+  auto matcher = path_to_regex::match("/users/:id");
+  path_to_regex::batch_matcher batch{matcher, 16};
+
+  std::vector<std::string_view> paths{"/users/1", "/posts/1", "/users/1", "/users/2", "/posts/1", "/users/1"};
+  std::vector<path_to_regex::matcher::result> results;
+  batch(paths, results);
+
+  ASSERT_EQ(results.size(), paths.size());
+  EXPECT_EQ(batch.unique_count(), 3);
+  for (size_t i = 0; i < paths.size(); ++i) {
+    auto expected = matcher(paths[i]);
+    EXPECT_EQ(results[i].matched, expected.matched) << paths[i];
+    EXPECT_EQ(results[i].params, expected.params) << paths[i];
+  }
+}
+
+TEST(Batch, ReusesTableAcrossBatches)
+{
+  auto matcher = path_to_regex::match("/:foo");
+  path_to_regex::batch_matcher batch{matcher, 4};
+  std::vector<path_to_regex::matcher::result> results;
+
+  batch({"/a", "/a", "/b"}, results);
+  EXPECT_EQ(batch.unique_count(), 2);
+
+  batch({"/b", "/c"}, results);
+  EXPECT_EQ(batch.unique_count(), 2);
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_EQ(results[0].params, (params_type{{"foo", "b"}}));
+  EXPECT_EQ(results[1].params, (params_type{{"foo", "c"}}));
+}
+
+TEST(Batch, MatchesDirectlyWhenTableIsFull)
+{
+  auto matcher = path_to_regex::match("/:foo");
+  path_to_regex::batch_matcher batch{matcher, 1};
+  std::vector<path_to_regex::matcher::result> results;
+
+  batch({"/a", "/b", "/b", "/a"}, results);
+  EXPECT_EQ(batch.unique_count(), 3);
+  EXPECT_EQ(results[2].params, (params_type{{"foo", "b"}}));
+  EXPECT_EQ(results[3].params, (params_type{{"foo", "a"}}));
+}
+
+TEST(Batch, DeduplicationDisabled)
+{
+  auto matcher = path_to_regex::match("/:foo");
+  path_to_regex::batch_matcher batch{matcher, 0};
+  std::vector<path_to_regex::matcher::result> results;
+
+  batch({"/a", "/a"}, results);
+  EXPECT_EQ(batch.unique_count(), 2);
+  EXPECT_TRUE(results[1].matched);
+}
+
+TEST(Batch, Corpus)
+{
+  std::vector<path_to_regex::matcher::result> results;
+  for (const auto& test : corpus::load_all()) {
+    SCOPED_TRACE("Pattern: " + test.pattern + ", path: " + test.path);
+    auto matcher = path_to_regex::match(test.pattern, test.sensitivity);
+    path_to_regex::batch_matcher batch{matcher};
+    batch({test.path, test.path}, results);
+    ASSERT_EQ(results.size(), 2);
+    for (const auto& res : results) {
+      EXPECT_EQ(res.matched, test.matched);
+      EXPECT_EQ(res.params, test.params);
+    }
+  }
+}
+
+} // namespace
@@ -0,0 +1,110 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <path_to_regex/chain.hpp>
+
+#include "corpus.hpp"
+
+namespace {
+
+using path_to_regex::match_mode;
+using params_type = std::unordered_map<std::string, std::string>;
+
+std::vector<size_t> ids(const std::vector<path_to_regex::chain_resolver::match>& matches)
+{
+  std::vector<size_t> result;
+  for (const auto& m : matches)
+    result.push_back(m.id);
+  return result;
+}
+
+TEST(Chain, MatchPrefix)
+{
+  auto m = path_to_regex::match_prefix("/api/:version");
+  EXPECT_TRUE(m("/api/v1").matched);
+  EXPECT_TRUE(m("/api/v1/").matched);
+  EXPECT_EQ(m("/api/v1/users/42").params, (params_type{{"version", "v1"}}));
+  EXPECT_FALSE(m("/api").matched);
+  EXPECT_FALSE(m("/apix/v1").matched);
+
+  m = path_to_regex::match_prefix("/api/");
+  EXPECT_TRUE(m("/api").matched);
+  EXPECT_TRUE(m("/api/users").matched);
+  EXPECT_FALSE(m("/apikeys").matched);
+
+  m = path_to_regex::match_prefix("\\docs", path_to_regex::case_sensitivity::case_insensitive);
+  EXPECT_TRUE(m("\\DOCS\\intro").matched);
+  EXPECT_FALSE(m("\\docsx").matched);
+}
+
+TEST(Chain, ResolvesAllMatchesInOrder)
+{
+  path_to_regex::chain_resolver chain{{
+    {"/", 1, match_mode::prefix},
+    {"/api", 2, match_mode::prefix},
+    {"/api/:version", 3, match_mode::prefix},
+    {"/API/admin", 4, match_mode::prefix, path_to_regex::case_sensitivity::case_insensitive},
+    {"/api/:version/users/:id", 5},
+    {"/api/v1/users/me", 6},
+    {"/static", 7, match_mode::prefix},
+  }};
+  EXPECT_EQ(chain.size(), 7);
+
+  auto matches = chain("/api/v1/users/42");
+  EXPECT_EQ(ids(matches), (std::vector<size_t>{1, 2, 3, 5}));
+  EXPECT_EQ(matches[2].params, (params_type{{"version", "v1"}}));
+  EXPECT_EQ(matches[3].params, (params_type{{"version", "v1"}, {"id", "42"}}));
+
+  EXPECT_EQ(ids(chain("/api/v1/users/me")), (std::vector<size_t>{1, 2, 3, 5, 6}));
+  EXPECT_EQ(ids(chain("/api/admin/stats")), (std::vector<size_t>{1, 2, 3, 4}));
+  EXPECT_EQ(ids(chain("/Api/admin")), (std::vector<size_t>{1, 4}));
+  EXPECT_EQ(ids(chain("/apikeys")), (std::vector<size_t>{1}));
+  EXPECT_EQ(ids(chain("/static/app.js")), (std::vector<size_t>{1, 7}));
+  EXPECT_EQ(ids(chain("")), (std::vector<size_t>{1}));
+
+  std::vector<path_to_regex::chain_resolver::match> reused{{42, {}}};
+  chain("/api", reused);
+  EXPECT_EQ(ids(reused), (std::vector<size_t>{1, 2}));
+}
+
+TEST(Chain, EncodedLiterals)
+{
+  path_to_regex::chain_resolver chain{{
+    {"/my files", 1, match_mode::prefix},
+    {"/my files/readme", 2},
+  }};
+
+  EXPECT_EQ(ids(chain("/my files/readme")), (std::vector<size_t>{1, 2}));
+  EXPECT_EQ(ids(chain("/my files/other")), (std::vector<size_t>{1}));
+  EXPECT_TRUE(chain("/my filesx").empty());
+  EXPECT_EQ(ids(chain("/my%20files/readme")), (std::vector<size_t>{1, 2}));
+  EXPECT_TRUE(path_to_regex::chain_resolver{}("/").empty());
+}
+
+TEST(Chain, Corpus)
+{
+  for (const auto& test : corpus::load_all()) {
+    SCOPED_TRACE("Pattern: " + test.pattern + ", path: " + test.path);
+    path_to_regex::chain_resolver chain{{{test.pattern, 1, match_mode::full, test.sensitivity}}};
+    auto matches = chain(test.path);
+    EXPECT_EQ(!matches.empty(), test.matched);
+    EXPECT_EQ(matches.empty() ? params_type{} : matches.front().params, test.params);
+  }
+}
+
+} // namespace
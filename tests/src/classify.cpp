@@ -0,0 +1,174 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hyperloglog.hpp"
+#include "space_saving.hpp"
+
+namespace {
+
+hyperloglog sketch_of(size_t begin, size_t end)
+{
+  hyperloglog sketch;
+  for (auto i = begin; i < end; ++i)
+    sketch.add("/users/" + std::to_string(i));
+  return sketch;
+}
+
+TEST(HyperLogLog, Empty)
+{
+  EXPECT_EQ(hyperloglog{}.estimate(), 0);
+}
+
+TEST(HyperLogLog, SmallCardinalities)
+{
+  for (size_t n : {1, 10, 100, 1000}) {
+    auto estimate = sketch_of(0, n).estimate();
+    EXPECT_NEAR(estimate, static_cast<double>(n), std::max(1.0, 0.05 * static_cast<double>(n))) << n;
+  }
+}
+
+TEST(HyperLogLog, LargeCardinalities)
+{
+  for (size_t n : {20000, 200000}) {
+    auto estimate = sketch_of(0, n).estimate();
+    // About three standard errors.
+    EXPECT_NEAR(estimate, static_cast<double>(n), 0.05 * static_cast<double>(n)) << n;
+  }
+}
+
+TEST(HyperLogLog, DuplicatesAreNotCounted)
+{
+  auto sketch = sketch_of(0, 5000);
+  auto estimate = sketch.estimate();
+  for (int repeat = 0; repeat < 3; ++repeat)
+    sketch.merge(sketch_of(0, 5000));
+  EXPECT_EQ(sketch.estimate(), estimate);
+}
+
+TEST(HyperLogLog, MergeEstimatesTheUnion)
+{
+  auto merged = sketch_of(0, 30000);
+  merged.merge(sketch_of(20000, 50000));
+  EXPECT_EQ(merged.estimate(), sketch_of(0, 50000).estimate());
+}
+
+using counts = std::map<std::string, uint64_t>;
+
+// Adds a skewed stream of values to a summary and to exact counts.
+void add_stream(space_saving& summary, counts& exact, std::mt19937& rng, size_t size, size_t values)
+{
+  std::geometric_distribution<size_t> distribution{0.1};
+  for (size_t i = 0; i < size; ++i) {
+    auto value = "v" + std::to_string(distribution(rng) % values);
+    summary.add(value);
+    ++exact[value];
+  }
+}
+
+// Every counter must bound the frequency of its value from above, with the error bounding the overestimation.
+void expect_bounds(const space_saving& summary, const counts& exact, size_t capacity)
+{
+  auto entries = summary.top(capacity + 1);
+  EXPECT_LE(entries.size(), capacity);
+  for (const auto& e : entries) {
+    auto it = exact.find(e.value);
+    auto frequency = it == exact.end() ? 0 : it->second;
+    EXPECT_GE(e.count, frequency) << e.value;
+    EXPECT_LE(e.count - e.error, frequency) << e.value;
+  }
+}
+
+TEST(SpaceSaving, ExactBelowCapacity)
+{
+  space_saving summary{8};
+  for (auto value : {"a", "b", "a", "c", "a", "b"})
+    summary.add(value);
+
+  auto top = summary.top(2);
+  ASSERT_EQ(top.size(), 2);
+  EXPECT_EQ(top[0].value, "a");
+  EXPECT_EQ(top[0].count, 3);
+  EXPECT_EQ(top[0].error, 0);
+  EXPECT_EQ(top[1].value, "b");
+  EXPECT_EQ(top[1].count, 2);
+}
+
+TEST(SpaceSaving, BoundsAndHeavyHitters)
+{
+  std::mt19937 rng{1};
+  space_saving summary{16};
+  counts exact;
+  add_stream(summary, exact, rng, 20000, 200);
+  expect_bounds(summary, exact, 16);
+
+  // A value more frequent than size / capacity is always kept.
+  auto top = summary.top(16);
+  for (const auto& [value, frequency] : exact) {
+    if (frequency > 20000 / 16) {
+      auto kept = std::any_of(top.begin(), top.end(), [&](const auto& e) { return e.value == value; });
+      EXPECT_TRUE(kept) << value;
+    }
+  }
+}
+
+TEST(SpaceSaving, MergeKeepsUpperBounds)
+{
+  std::mt19937 rng{2};
+  for (int round = 0; round < 20; ++round) {
+    space_saving lhs{8};
+    space_saving rhs{8};
+    counts exact;
+    add_stream(lhs, exact, rng, 2000, 64);
+    add_stream(rhs, exact, rng, 500, 64);
+
+    lhs.merge(rhs);
+    expect_bounds(lhs, exact, 8);
+  }
+}
+
+TEST(SpaceSaving, MergeCountsValuesEvictedFromOneSide)
+{
+  space_saving lhs{2};
+  for (auto value : {"a", "a", "a", "b", "b", "x"})
+    lhs.add(value);
+  // "x" replaced "b" in lhs, which is full with a minimum count of 3.
+
+  space_saving rhs{2};
+  for (auto value : {"b", "b", "b", "b"})
+    rhs.add(value);
+
+  lhs.merge(rhs);
+  counts exact{{"a", 3}, {"b", 6}, {"x", 1}};
+  expect_bounds(lhs, exact, 2);
+
+  auto top = lhs.top(2);
+  ASSERT_EQ(top.size(), 2);
+  EXPECT_EQ(top[0].value, "b");
+  EXPECT_EQ(top[0].count, 7);
+  EXPECT_EQ(top[1].value, "x");
+}
+
+} // namespace
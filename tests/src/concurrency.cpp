@@ -0,0 +1,116 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <path_to_regex.hpp>
+#include <path_to_regex/router.hpp>
+#include <path_to_regex/snapshots.hpp>
+
+namespace {
+
+constexpr size_t threads_count = 8;
+constexpr size_t iterations = 500;
+
+template<typename F>
+void run_threads(F&& f)
+{
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < threads_count; ++t)
+    threads.emplace_back([&f, t] { f(t); });
+  for (auto& thread : threads)
+    thread.join();
+}
+
+TEST(Concurrency, SharedMatcher)
+{
+  const auto matcher = path_to_regex::match("/tenants/:tenant/files/*path{.:ext}");
+
+  std::vector<std::string> paths;
+  std::vector<path_to_regex::matcher::result> expected;
+  for (size_t i = 0; i < 64; ++i) {
+    paths.push_back("/tenants/t" + std::to_string(i) + (i % 3 ? "/files/a/b" + std::to_string(i) + ".txt" : "/x"));
+    expected.push_back(matcher(paths.back()));
+  }
+
+  std::atomic<size_t> mismatches{0};
+  run_threads([&](size_t t) {
+    for (size_t i = 0; i < iterations; ++i) {
+      auto index = (i * 31 + t) % paths.size();
+      auto res = matcher(paths[index]);
+      if (res.matched != expected[index].matched || res.params != expected[index].params) ++mismatches;
+    }
+  });
+
+  EXPECT_EQ(mismatches, 0);
+}
+
+TEST(Concurrency, ConcurrentCompilation)
+{
+  std::atomic<size_t> mismatches{0};
+  run_threads([&](size_t t) {
+    for (size_t i = 0; i < iterations / 10; ++i) {
+      auto id = std::to_string(t * iterations + i);
+      auto matcher =
+        path_to_regex::match("/users/" + id + "/:name{.:ext}", path_to_regex::case_sensitivity::case_insensitive);
+      auto res = matcher("/USERS/" + id + "/photo.png");
+      if (!res.matched || res.params.at("name") != "photo" || res.params.at("ext") != "png") ++mismatches;
+    }
+  });
+
+  EXPECT_EQ(mismatches, 0);
+}
+
+TEST(Concurrency, SharedRouterDuringPublish)
+{
+  path_to_regex::route_snapshots snapshots;
+  snapshots.publish({{"/users/:id", 1}, {"/users/me", 2}});
+
+  std::atomic<bool> done{false};
+  std::atomic<size_t> mismatches{0};
+  std::thread writer{[&] {
+    for (size_t i = 0; i < iterations / 10; ++i) {
+      auto version = "/v" + std::to_string(i);
+      if (i % 2)
+        snapshots.publish({{"/users/:id", 1}, {"/users/me", 2}, {version, 3}});
+      else
+        snapshots.publish({{"/users/me", 2}, {"/users/:id", 1}, {version, 3}});
+    }
+    done = true;
+  }};
+
+  run_threads([&](size_t) {
+    do {
+      auto router = snapshots.current();
+      auto res = (*router)("/users/42");
+      if (!res.matched || res.id != 1 || res.params.at("id") != "42") ++mismatches;
+
+      res = (*router)("/users/me");
+      auto me = res.id == 1 ? res.params.at("id") == "me" : res.id == 2 && res.params.empty();
+      if (!res.matched || !me) ++mismatches;
+    } while (!done);
+  });
+  writer.join();
+
+  EXPECT_EQ(mismatches, 0);
+}
+
+} // namespace
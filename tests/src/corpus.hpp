@@ -0,0 +1,202 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_TESTS_CORPUS_H
+#define PATH_TO_REGEX_TESTS_CORPUS_H
+
+#include <cctype>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <path_to_regex/common.hpp>
+
+namespace corpus {
+
+/**
+ * @brief A pattern, a path and the expected match result.
+ */
+struct test_case {
+  std::string pattern;
+  std::string path;
+  bool matched = false;
+  std::unordered_map<std::string, std::string> params;
+  path_to_regex::case_sensitivity sensitivity = path_to_regex::case_sensitivity::case_sensitive;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const test_case& tc)
+{
+  os << "{ pattern: \"" << tc.pattern << "\", " << "path: \"" << tc.path << "\", " << "matched: " << std::boolalpha
+     << tc.matched << ", " << "params: {";
+  for (const auto& [key, value] : tc.params)
+    os << "\"" << key << "\": \"" << value << "\", ";
+  if (!tc.params.empty()) os.seekp(-2, std::ios_base::end);
+  os << "} }";
+  return os;
+}
+
+namespace details {
+
+class line_parser {
+public:
+  line_parser(std::string_view line, const std::string& where)
+    : m_line{line}
+    , m_where{where}
+  {}
+
+  bool at_end()
+  {
+    skip_spaces();
+    return m_pos == m_line.size();
+  }
+
+  std::string word()
+  {
+    skip_spaces();
+    auto start = m_pos;
+    while (m_pos < m_line.size() && !std::isspace(static_cast<unsigned char>(m_line[m_pos])))
+      ++m_pos;
+    return std::string{m_line.substr(start, m_pos - start)};
+  }
+
+  bool peek(char ch)
+  {
+    skip_spaces();
+    return m_pos < m_line.size() && m_line[m_pos] == ch;
+  }
+
+  void expect(char ch)
+  {
+    if (m_pos >= m_line.size() || m_line[m_pos] != ch) fail(std::string{"expected '"} + ch + "'");
+    ++m_pos;
+  }
+
+  std::string quoted()
+  {
+    skip_spaces();
+    expect('"');
+    std::string text;
+    for (;;) {
+      if (m_pos >= m_line.size()) fail("unterminated string");
+      auto ch = m_line[m_pos++];
+      if (ch == '"') return text;
+      if (ch != '\\') {
+        text += ch;
+        continue;
+      }
+      if (m_pos >= m_line.size()) fail("unterminated escape");
+      ch = m_line[m_pos++];
+      if (ch == '\\' || ch == '"') {
+        text += ch;
+      } else if (ch == 'x' && m_pos + 2 <= m_line.size() && std::isxdigit(static_cast<unsigned char>(m_line[m_pos])) &&
+                 std::isxdigit(static_cast<unsigned char>(m_line[m_pos + 1]))) {
+        text += static_cast<char>(std::stoi(std::string{m_line.substr(m_pos, 2)}, nullptr, 16));
+        m_pos += 2;
+      } else {
+        fail("invalid escape");
+      }
+    }
+  }
+
+  [[noreturn]] void fail(const std::string& message) const
+  {
+    throw std::runtime_error{m_where + ": " + message};
+  }
+
+private:
+  void skip_spaces()
+  {
+    while (m_pos < m_line.size() && std::isspace(static_cast<unsigned char>(m_line[m_pos])))
+      ++m_pos;
+  }
+
+  std::string_view m_line;
+  const std::string& m_where;
+  size_t m_pos = 0;
+};
+
+} // namespace details
+
+/**
+ * @brief Loads the cases of a corpus file.
+ *
+ * Every non-empty line not starting with `#` is `PATTERN PATH RESULT [ci] [NAME=VALUE...]`,
+ * see tests/data/cases.txt.
+ *
+ * @throw std::runtime_error If the file cannot be read or a line is malformed.
+ */
+inline std::vector<test_case> load(const std::string& file)
+{
+  std::ifstream in{file};
+  if (!in) throw std::runtime_error{"Cannot open " + file};
+
+  std::vector<test_case> cases;
+  std::string line;
+  for (size_t number = 1; std::getline(in, line); ++number) {
+    auto where = file + ":" + std::to_string(number);
+    details::line_parser parser{line, where};
+    if (parser.at_end() || parser.peek('#')) continue;
+
+    test_case tc;
+    tc.pattern = parser.quoted();
+    tc.path = parser.quoted();
+
+    auto result = parser.word();
+    if (result != "match" && result != "miss") parser.fail("expected match or miss");
+    tc.matched = result == "match";
+
+    if (!parser.at_end() && !parser.peek('"')) {
+      if (parser.word() != "ci") parser.fail("expected ci");
+      tc.sensitivity = path_to_regex::case_sensitivity::case_insensitive;
+    }
+
+    while (!parser.at_end()) {
+      auto name = parser.quoted();
+      parser.expect('=');
+      tc.params[name] = parser.quoted();
+    }
+    if (!tc.matched && !tc.params.empty()) parser.fail("params of a miss");
+
+    cases.push_back(std::move(tc));
+  }
+
+  return cases;
+}
+
+#ifdef PATH_TO_REGEX_CORPUS_DIR
+/**
+ * @brief Loads the hand-written and the generated cases.
+ */
+inline const std::vector<test_case>& load_all()
+{
+  static const auto cases = [] {
+    auto all = load(PATH_TO_REGEX_CORPUS_DIR "/cases.txt");
+    auto generated = load(PATH_TO_REGEX_CORPUS_DIR "/generated_cases.txt");
+    all.insert(all.end(), generated.begin(), generated.end());
+    return all;
+  }();
+  return cases;
+}
+#endif
+
+} // namespace corpus
+
+#endif // PATH_TO_REGEX_TESTS_CORPUS_H
@@ -0,0 +1,111 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+#include <generated_routes.hpp>
+#include <path_to_regex/route_file.hpp>
+
+namespace {
+
+using params_type = std::unordered_map<std::string, std::string>;
+
+std::string read_routes()
+{
+  std::ifstream file{PATH_TO_REGEX_TEST_ROUTES};
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+class GeneratedRouter : public ::testing::TestWithParam<std::string> {
+protected:
+  static void SetUpTestSuite()
+  {
+    text = read_routes();
+    auto file = path_to_regex::parse_route_file(text);
+    ASSERT_TRUE(file.ok());
+    reference = path_to_regex::router{file.routes};
+  }
+
+  static std::string text;
+  static path_to_regex::router reference;
+};
+
+std::string GeneratedRouter::text;
+path_to_regex::router GeneratedRouter::reference;
+
+TEST_P(GeneratedRouter, MatchesLikeRouter)
+{
+  const auto& path = GetParam();
+  auto expected = reference(path);
+  auto actual = generated::match(path);
+
+  EXPECT_EQ(actual.matched, expected.matched);
+  EXPECT_EQ(actual.id, expected.id);
+  EXPECT_EQ(actual.params, expected.params);
+}
+
+// clang-format off
+INSTANTIATE_TEST_SUITE_P(Paths, GeneratedRouter, ::testing::Values(
+  "", "/", "//", "/static/about", "/static/about/", "/STATIC/about", "/static",
+  "/t1", "/t1/", "/t1/x", "/t1x",
+  "/t2/x", "/t2/x/", "/t2/x/y", "/t2/", "/t2/new", "/t2/new/",
+  "/t3/x", "/t3/x/", "/t3/x//",
+  "/t4/x/y", "/t4/x/y/", "/t4/x", "/t4/x/y/z",
+  "/t5/x.y", "/t5/x.y.z", "/t5/x", "/t5/.y", "/t5/x./",
+  "/t6/foo.y", "/t6/foo.y/", "/t6/foo.",
+  "/t7/x/bar", "/t7/x/bar/", "/t7/x/baz",
+  "/t8/y", "/t8/x/y", "/t8/x/y/", "/t8", "/t8/x/y/z",
+  "/t9/x", "/t9/x/", "/t9/x/y", "/t9/x/y/", "/t9/x/y/z",
+  "/t10", "/t10/", "/t10/x", "/t10/x/", "/t10/x/y", "/t10/x/y/", "/t10/x//",
+  "/t11/x", "/t11/x/y", "/t11/x/y/z/",
+  "/t12/café", "/t12/caf%C3%A9/", "/t12/cafe",
+  "/t13/x", "/t13/a%2Fb", "/t13/param%2523", "/t13/é",
+  "/t14/123", "/t14/12", "/t14/123/",
+  "/t15/foo/bar", "/T15/FOO/BAR/", "/t15/foo/baz",
+  "/t16/archive", "/t16/archive.zip", "/t16/a.b.c", "/t16/.zip",
+  "/t17", "/t17/a", "/t17/a/b/c/d/e", "/t17/b/d", "/t17/e/a",
+  "/t18/x", "/t18/x/", "/t18/",
+  "/t19/;,:@&=+$-_.!~*()", "/t19/;,",
+  "t20\\C:\\x", "t20\\C:\\x\\", "t20\\C:\\x\\y", "t20\\C:\\",
+  "/t21/a-b-c", "/t21/a-b", "/t21/a-b-c-d", "/t21/a--b",
+  "/home", "/en/home", "/en/home/", "/en/x/home",
+  "/unknown", "/t99/x"
+));
+// clang-format on
+
+TEST(GeneratedRouterTest, Results)
+{
+  auto res = generated::match("/t5/x.y.z");
+  EXPECT_TRUE(res.matched);
+  EXPECT_EQ(res.id, 5);
+  EXPECT_EQ(res.params, (params_type{{"foo", "x"}, {"bar", "y.z"}}));
+
+  res = generated::match("/T15/FOO/BAR/");
+  EXPECT_TRUE(res.matched);
+  EXPECT_EQ(res.id, 15);
+
+  res = generated::match("/en/home");
+  EXPECT_TRUE(res.matched);
+  EXPECT_EQ(res.id, 23);
+  EXPECT_EQ(res.params, (params_type{{"lang", "en"}}));
+}
+
+} // namespace
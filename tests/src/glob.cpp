@@ -0,0 +1,215 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <climits>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <path_to_regex/glob.hpp>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+using entries = std::map<std::string, std::unordered_map<std::string, std::string>>;
+
+class Glob : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    m_root = fs::temp_directory_path() / ("path_to_regex_glob_" + std::to_string(::getpid()));
+    fs::remove_all(m_root);
+    for (auto file : {"src/app/main.cpp", "src/app/util.cpp", "src/lib/io/file.cpp", "docs/index.md", "README.md"})
+      touch(file);
+    fs::create_directories(m_root / "src/empty");
+    fs::create_directory_symlink(m_root / "src", m_root / "link");
+  }
+
+  void TearDown() override
+  {
+    fs::remove_all(m_root);
+  }
+
+  void touch(const std::string& file) const
+  {
+    fs::create_directories((m_root / file).parent_path());
+    std::ofstream{m_root / file};
+  }
+
+  entries walk(std::string_view pattern, size_t* directories = nullptr,
+               path_to_regex::case_sensitivity sensitivity = path_to_regex::case_sensitivity::case_sensitive,
+               size_t threads = 4) const
+  {
+    entries found;
+    path_to_regex::glob_walker walker{pattern, sensitivity, threads};
+    auto count = walker(m_root.string(), [&](path_to_regex::glob_walker::entry&& e) {
+      EXPECT_TRUE(found.emplace(e.path, std::move(e.params)).second) << e.path;
+    });
+    if (directories) *directories = count;
+    return found;
+  }
+
+  fs::path m_root;
+};
+
+TEST_F(Glob, MatchesWithParams)
+{
+  EXPECT_EQ(walk("/src/:module/:file"), (entries{
+                                          {"/src/app/main.cpp", {{"module", "app"}, {"file", "main.cpp"}}},
+                                          {"/src/app/util.cpp", {{"module", "app"}, {"file", "util.cpp"}}},
+                                          {"/src/lib/io", {{"module", "lib"}, {"file", "io"}}},
+                                        }));
+}
+
+TEST_F(Glob, MatchesDirectoriesAndSymlinks)
+{
+  std::map<std::string, bool> found;
+  path_to_regex::glob_walker walker{"/:name"};
+  walker(m_root.string(), [&](path_to_regex::glob_walker::entry&& e) { found[e.path] = e.directory; });
+
+  EXPECT_EQ(found, (std::map<std::string, bool>{
+                     {"/README.md", false}, {"/docs", true}, {"/link", false}, {"/src", true}}));
+}
+
+TEST_F(Glob, PrunesByLiteralPrefix)
+{
+  size_t directories = 0;
+  EXPECT_EQ(walk("/src/app/:file", &directories).size(), 2);
+  // The root, /src and /src/app.
+  EXPECT_EQ(directories, 3);
+
+  EXPECT_EQ(walk("/docs/:file", &directories), (entries{{"/docs/index.md", {{"file", "index.md"}}}}));
+  EXPECT_EQ(directories, 2);
+
+  EXPECT_TRUE(walk("/missing/:file", &directories).empty());
+  EXPECT_EQ(directories, 1);
+}
+
+TEST_F(Glob, PrunesByDepth)
+{
+  size_t directories = 0;
+  EXPECT_EQ(walk("/:dir/:file", &directories).size(), 4);
+  // The root, /docs and /src, but none of their subdirectories.
+  EXPECT_EQ(directories, 3);
+
+  EXPECT_EQ(walk("/:dir{/:sub}/", &directories).size(), 8);
+  EXPECT_EQ(directories, 3);
+}
+
+TEST_F(Glob, WildcardDescendsEverywhere)
+{
+  size_t directories = 0;
+  auto found = walk("/src/*path", &directories);
+  EXPECT_EQ(found.size(), 7);
+  EXPECT_EQ(found["/src/lib/io/file.cpp"], (std::unordered_map<std::string, std::string>{{"path", "lib/io/file.cpp"}}));
+  // Everything but /docs, and /link is not followed.
+  EXPECT_EQ(directories, 6);
+}
+
+TEST_F(Glob, CaseInsensitive)
+{
+  size_t directories = 0;
+  auto found = walk("/SRC/App/:file", &directories, path_to_regex::case_sensitivity::case_insensitive);
+  EXPECT_EQ(found.size(), 2);
+  EXPECT_EQ(directories, 3);
+
+  EXPECT_TRUE(walk("/SRC/App/:file").empty());
+}
+
+TEST_F(Glob, BackslashSeparator)
+{
+  EXPECT_EQ(walk("\\docs\\:file"), (entries{{"\\docs\\index.md", {{"file", "index.md"}}}}));
+}
+
+TEST_F(Glob, SameMatchesOnAnyNumberOfThreads)
+{
+  for (size_t i = 0; i < 20; ++i) {
+    for (size_t j = 0; j < 20; ++j)
+      touch("tree/" + std::to_string(i) + "/" + std::to_string(j % 4) + "/" + std::to_string(j) + ".txt");
+  }
+
+  size_t directories = 0;
+  auto expected = walk("/tree/*path", &directories, path_to_regex::case_sensitivity::case_sensitive, 1);
+  EXPECT_EQ(expected.size(), 20 + 20 * 4 + 20 * 20);
+  EXPECT_EQ(directories, 2 + 20 + 20 * 4);
+
+  for (size_t threads : {2, 8, 32}) {
+    size_t parallel_directories = 0;
+    EXPECT_EQ(walk("/tree/*path", &parallel_directories, path_to_regex::case_sensitivity::case_sensitive, threads),
+              expected);
+    EXPECT_EQ(parallel_directories, directories);
+  }
+}
+
+TEST_F(Glob, DeeperThanPathMax)
+{
+  // Built relative to each parent, as the full path is too long for the system calls.
+  const std::string name(200, 'd');
+  const size_t levels = PATH_MAX / name.size() + 2;
+  std::vector<int> fds{::open(m_root.c_str(), O_RDONLY | O_DIRECTORY)};
+  for (size_t i = 0; i < levels; ++i) {
+    ASSERT_EQ(::mkdirat(fds.back(), name.c_str(), 0755), 0);
+    fds.push_back(::openat(fds.back(), name.c_str(), O_RDONLY | O_DIRECTORY));
+    ASSERT_GE(fds.back(), 0);
+  }
+  ::close(::openat(fds.back(), "leaf.txt", O_CREAT | O_WRONLY, 0644));
+
+  size_t directories = 0;
+  auto found = walk("/" + name + "/*path", &directories);
+  EXPECT_EQ(found.size(), levels);
+  EXPECT_EQ(directories, levels + 1);
+
+  std::string leaf;
+  for (size_t i = 0; i < levels; ++i)
+    leaf += "/" + name;
+  leaf += "/leaf.txt";
+  EXPECT_GT(leaf.size(), PATH_MAX);
+  EXPECT_EQ(found.count(leaf), 1);
+
+  ::unlinkat(fds.back(), "leaf.txt", 0);
+  for (size_t i = levels; i > 0; --i) {
+    ::close(fds[i]);
+    ::unlinkat(fds[i - 1], name.c_str(), AT_REMOVEDIR);
+  }
+  ::close(fds[0]);
+}
+
+TEST_F(Glob, RethrowsCallbackExceptions)
+{
+  path_to_regex::glob_walker walker{"/src/*path"};
+  EXPECT_THROW(walker(m_root.string(), [](auto&&) { throw std::runtime_error{"stop"}; }), std::runtime_error);
+}
+
+TEST_F(Glob, Errors)
+{
+  path_to_regex::glob_walker walker{"/:file"};
+  EXPECT_THROW(walker((m_root / "missing").string(), [](auto&&) {}), std::system_error);
+  EXPECT_THROW(walker((m_root / "README.md").string(), [](auto&&) {}), std::system_error);
+  EXPECT_THROW(path_to_regex::glob_walker{"/:id(\\d+)"}, std::invalid_argument);
+}
+
+} // namespace
@@ -0,0 +1,63 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+import path_to_regex;
+
+namespace {
+
+using params_type = std::unordered_map<std::string, std::string>;
+
+TEST(Module, Matchers)
+{
+  auto matcher = path_to_regex::match("/users/:id");
+  auto res = matcher("/users/42");
+  EXPECT_TRUE(res.matched);
+  EXPECT_EQ(res.params, (params_type{{"id", "42"}}));
+
+  EXPECT_TRUE(path_to_regex::match_prefix("/api")("/api/users").matched);
+  EXPECT_TRUE(path_to_regex::native::match("/files/*path")("/files/a/b").matched);
+
+  auto compiled = path_to_regex::try_match("/:id(\\d{3)");
+  EXPECT_EQ(compiled.status, path_to_regex::match_status::invalid_pattern);
+}
+
+TEST(Module, Routing)
+{
+  auto file = path_to_regex::parse_route_file("/users/new id=1\n/users/:id id=2\n");
+  ASSERT_TRUE(file.ok());
+
+  path_to_regex::router router{file.routes};
+  EXPECT_EQ(router("/users/42").id, 2);
+
+  path_to_regex::chain_resolver chain{{{"/api", 1, path_to_regex::match_mode::prefix}, {"/api/status", 2}}};
+  EXPECT_EQ(chain("/api/status").size(), 2);
+
+  auto matcher = path_to_regex::match("/users/:id");
+  path_to_regex::batch_matcher batch{matcher, 4};
+  std::vector<path_to_regex::matcher::result> results;
+  batch({"/users/1", "/posts/1", "/users/1"}, results);
+  EXPECT_EQ(batch.unique_count(), 2);
+}
+
+} // namespace
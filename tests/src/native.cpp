@@ -0,0 +1,152 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+// Checked first, before other headers can pull in <regex>.
+#include <path_to_regex/native.hpp>
+#ifdef _GLIBCXX_REGEX
+#error "<path_to_regex/native.hpp> must not include <regex>"
+#endif
+
+#include <gtest/gtest.h>
+#include <path_to_regex.hpp>
+
+#include "corpus.hpp"
+
+namespace {
+
+using params_type = std::unordered_map<std::string, std::string>;
+using path_to_regex::case_sensitivity;
+
+TEST(Native, Match)
+{
+  auto matcher = path_to_regex::native::match("/users/:id/files/*path");
+
+  auto res = matcher("/users/42/files/a/b%20c.txt");
+  EXPECT_TRUE(res.matched);
+  EXPECT_EQ(res.params, (params_type{{"id", "42"}, {"path", "a/b c.txt"}}));
+  EXPECT_FALSE(matcher("/users/42/files").matched);
+  EXPECT_FALSE(matcher("/users//files/a").matched);
+}
+
+TEST(Native, RejectsCustomSubpatterns)
+{
+  EXPECT_THROW(path_to_regex::native::match("/users/:id(\\d+)"), std::invalid_argument);
+  EXPECT_THROW(path_to_regex::native::match("{/:id(\\d+)}"), std::invalid_argument);
+  EXPECT_NO_THROW(path_to_regex::native::match("/users/:id()"));
+}
+
+TEST(Native, SameResultsAsRegexEngine)
+{
+  const char* patterns[] = {
+    "",
+    "/",
+    "/users",
+    "/users/",
+    "/users/:id",
+    "/users/:id/",
+    "/:a-:b",
+    "/:a.:b",
+    "/files/*path",
+    "/files/*path/raw",
+    "/*a/*b",
+    "/download/:file{.:ext}",
+    "{/:lang}/about",
+    "/a{/b}{/c}/d",
+    "/{:x}",
+    "/my files/:name",
+    "/caf\xc3\xa9/:id",
+    "\\docs\\:page",
+    "/:id/:id",
+    "/price/$:amount",
+    "/{unclosed",
+    "/literal:",
+    "/(group)/:id",
+  };
+  const char* paths[] = {
+    "",
+    "/",
+    "//",
+    "/users",
+    "/users/",
+    "/USERS/42",
+    "/users/42",
+    "/users/42/",
+    "/users/42//",
+    "/users/4 2",
+    "/x-y-z",
+    "/x.y.z",
+    "/files",
+    "/files/",
+    "/files/a",
+    "/files/a/b/c",
+    "/files/a/b/raw",
+    "/files/a/raw/raw/",
+    "/a/b/c",
+    "/download/archive",
+    "/download/archive.tar.gz",
+    "/about",
+    "/en/about",
+    "/en/fr/about",
+    "/a/d",
+    "/a/b/d",
+    "/a/c/d",
+    "/a/b/c/d",
+    "/a/c/b/d",
+    "/my files/notes",
+    "/my%20files/notes",
+    "/caf\xc3\xa9/1",
+    "/CAF\xc3\xa9/1",
+    "\\docs\\intro",
+    "\\DOCS\\intro\\",
+    "/1/2",
+    "/price/$10",
+    "/{unclosed",
+    "/literal:",
+    "/(group)/7",
+  };
+
+  for (auto sensitivity : {case_sensitivity::case_sensitive, case_sensitivity::case_insensitive}) {
+    for (const auto* pattern : patterns) {
+      auto expected = path_to_regex::match(pattern, sensitivity);
+      auto actual = path_to_regex::native::match(pattern, sensitivity);
+      for (const auto* path : paths) {
+        auto lhs = expected(path);
+        auto rhs = actual(path);
+        EXPECT_EQ(lhs.matched, rhs.matched) << pattern << " " << path;
+        EXPECT_EQ(lhs.params, rhs.params) << pattern << " " << path;
+      }
+    }
+  }
+}
+
+TEST(Native, Corpus)
+{
+  for (const auto& test : corpus::load_all()) {
+    SCOPED_TRACE("Pattern: " + test.pattern + ", path: " + test.path);
+    std::optional<path_to_regex::native::matcher> matcher;
+    try {
+      matcher = path_to_regex::native::match(test.pattern, test.sensitivity);
+    } catch (const std::invalid_argument&) {
+      continue;
+    }
+    auto res = (*matcher)(test.path);
+    EXPECT_EQ(res.matched, test.matched);
+    EXPECT_EQ(res.params, test.params);
+  }
+}
+
+} // namespace
@@ -0,0 +1,117 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <path_to_regex/overlay.hpp>
+
+namespace {
+
+using params_type = std::unordered_map<std::string, std::string>;
+
+std::shared_ptr<const path_to_regex::router> make_base()
+{
+  return std::make_shared<const path_to_regex::router>(std::vector<path_to_regex::route>{
+    {"/users/:id", 1},
+    {"/about", 2},
+  });
+}
+
+TEST(Overlay, OverlayBeforeBase)
+{
+  path_to_regex::overlay_router router{make_base()};
+  router.add_tenant("acme", {{"/users/me", 10}, {"/reports/:year", 11}});
+
+  auto res = router("acme", "/users/me");
+  EXPECT_TRUE(res.matched);
+  EXPECT_EQ(res.id, 10);
+
+  res = router("acme", "/users/42");
+  EXPECT_EQ(res.id, 1);
+  EXPECT_EQ(res.params, (params_type{{"id", "42"}}));
+
+  res = router("acme", "/reports/2025");
+  EXPECT_EQ(res.id, 11);
+
+  res = router("globex", "/users/me");
+  EXPECT_EQ(res.id, 1);
+  EXPECT_FALSE(router("globex", "/reports/2025").matched);
+}
+
+TEST(Overlay, AddReplaceRemoveTenants)
+{
+  path_to_regex::overlay_router router{make_base()};
+  auto shared = std::make_shared<const path_to_regex::router>(std::vector<path_to_regex::route>{{"/about", 20}});
+
+  router.add_tenant("a", shared);
+  router.add_tenant("b", shared);
+  router.add_tenant("c", std::vector<path_to_regex::route>{});
+  EXPECT_EQ(router.size(), 3);
+  EXPECT_EQ(router("a", "/about").id, 20);
+  EXPECT_EQ(router("b", "/about").id, 20);
+  EXPECT_EQ(router("c", "/about").id, 2);
+
+  router.add_tenant("a", {{"/about", 30}});
+  EXPECT_EQ(router("a", "/about").id, 30);
+  EXPECT_EQ(router.size(), 3);
+
+  EXPECT_TRUE(router.remove_tenant("b"));
+  EXPECT_FALSE(router.remove_tenant("b"));
+  EXPECT_EQ(router("b", "/about").id, 2);
+  EXPECT_EQ(router.size(), 2);
+}
+
+TEST(Overlay, SharedBaseReplacement)
+{
+  path_to_regex::overlay_router router{make_base()};
+  router.add_tenant("acme", {{"/reports", 10}});
+  auto table = router.tenant("acme");
+
+  router.set_base(std::make_shared<const path_to_regex::router>(std::vector<path_to_regex::route>{{"/about", 3}}));
+  EXPECT_EQ(router("acme", "/about").id, 3);
+  EXPECT_EQ(router("acme", "/reports").id, 10);
+  EXPECT_EQ(router.tenant("acme")("/about").id, 3);
+  EXPECT_EQ(table("/reports").id, 10);
+}
+
+TEST(Overlay, TablesKeepTheirBase)
+{
+  path_to_regex::overlay_router router{make_base()};
+  router.add_tenant("acme", {{"/reports", 10}});
+  auto table = router.tenant("acme");
+  auto unknown = router.tenant("globex");
+
+  router.set_base(std::make_shared<const path_to_regex::router>(std::vector<path_to_regex::route>{{"/about", 3}}));
+  router.remove_tenant("acme");
+
+  // Base-only paths are routed by the base the tables were created with.
+  EXPECT_EQ(table("/about").id, 2);
+  EXPECT_EQ(table("/users/7").id, 1);
+  EXPECT_EQ(table("/reports").id, 10);
+  EXPECT_EQ(unknown("/users/7").id, 1);
+  EXPECT_FALSE(router("acme", "/users/7").matched);
+}
+
+TEST(Overlay, RejectsNullBase)
+{
+  EXPECT_THROW(path_to_regex::overlay_router{nullptr}, std::invalid_argument);
+
+  path_to_regex::overlay_router router{make_base()};
+  EXPECT_THROW(router.set_base(nullptr), std::invalid_argument);
+  EXPECT_EQ(router("acme", "/about").id, 2);
+}
+
+} // namespace
@@ -0,0 +1,92 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <path_to_regex/route_file.hpp>
+
+namespace {
+
+TEST(RouteFile, Parse)
+{
+  constexpr std::string_view text = "# routes\n"
+                                    "/users/:id id=7\n"
+                                    "\n"
+                                    "  /files/*path\tcase_insensitive   # static files\r\n"
+                                    "/about";
+  auto file = path_to_regex::parse_route_file(text);
+
+  EXPECT_TRUE(file.ok());
+  ASSERT_EQ(file.routes.size(), 3);
+  EXPECT_EQ(file.lines, (std::vector<size_t>{2, 4, 5}));
+
+  EXPECT_EQ(file.routes[0].pattern, "/users/:id");
+  EXPECT_EQ(file.routes[0].id, 7);
+  EXPECT_EQ(file.routes[0].sensitivity, path_to_regex::case_sensitivity::case_sensitive);
+  EXPECT_EQ(file.routes[1].pattern, "/files/*path");
+  EXPECT_EQ(file.routes[1].id, 1);
+  EXPECT_EQ(file.routes[1].sensitivity, path_to_regex::case_sensitivity::case_insensitive);
+  EXPECT_EQ(file.routes[2].pattern, "/about");
+  EXPECT_EQ(file.routes[2].id, 2);
+
+  EXPECT_GE(file.routes[0].pattern.data(), text.data());
+  EXPECT_LT(file.routes[0].pattern.data(), text.data() + text.size());
+
+  path_to_regex::router router{file.routes};
+  EXPECT_EQ(router("/FILES/x").id, 1);
+}
+
+TEST(RouteFile, ReportsAllErrors)
+{
+  auto file = path_to_regex::parse_route_file("/a id=x\n"
+                                              "/b{/:c\n"
+                                              "/d fast\n"
+                                              "/e}\n"
+                                              "/f id=18446744073709551616\n");
+
+  EXPECT_FALSE(file.ok());
+  ASSERT_EQ(file.errors.size(), 5);
+  EXPECT_EQ(file.errors[0].line, 1);
+  EXPECT_EQ(file.errors[0].column, 7);
+  EXPECT_EQ(file.errors[1].line, 2);
+  EXPECT_EQ(file.errors[1].column, 3);
+  EXPECT_EQ(file.errors[2].line, 3);
+  EXPECT_EQ(file.errors[2].column, 4);
+  EXPECT_EQ(file.errors[2].message, "unknown option 'fast'");
+  EXPECT_EQ(file.errors[3].line, 4);
+  EXPECT_EQ(file.errors[3].column, 3);
+  EXPECT_EQ(file.errors[4].line, 5);
+}
+
+TEST(RouteFile, ReportsInvalidSubpatterns)
+{
+  auto file = path_to_regex::parse_route_file("/users/:id(\\d+)   id=1\n"
+                                              "  /posts/:id(*x)   id=2\n"
+                                              "/files/:name([a-) case_insensitive\n"
+                                              "/a x\n");
+
+  EXPECT_FALSE(file.ok());
+  ASSERT_EQ(file.errors.size(), 3);
+  EXPECT_EQ(file.errors[0].line, 2);
+  EXPECT_EQ(file.errors[0].column, 13);
+  EXPECT_EQ(file.errors[0].message, "invalid custom subpattern");
+  EXPECT_EQ(file.errors[1].line, 3);
+  EXPECT_EQ(file.errors[1].column, 13);
+  EXPECT_EQ(file.errors[2].line, 4);
+  EXPECT_EQ(file.routes.size(), 4);
+}
+
+} // namespace
@@ -0,0 +1,180 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <regex>
+#include <sstream>
+
+#include <gtest/gtest.h>
+#include <path_to_regex/router.hpp>
+
+#include "corpus.hpp"
+
+namespace {
+
+using params_type = std::unordered_map<std::string, std::string>;
+
+std::vector<path_to_regex::route> make_routes()
+{
+  return {
+    {"/users/new", 1},
+    {"/users/:id", 2},
+    {"/FILES/*path", 3, path_to_regex::case_sensitivity::case_insensitive},
+    {"{/:lang}/about", 4},
+  };
+}
+
+void check_router(const path_to_regex::router& router)
+{
+  auto res = router("/users/new");
+  EXPECT_TRUE(res.matched);
+  EXPECT_EQ(res.id, 1);
+
+  res = router("/users/42");
+  EXPECT_TRUE(res.matched);
+  EXPECT_EQ(res.id, 2);
+  EXPECT_EQ(res.params, (params_type{{"id", "42"}}));
+
+  res = router("/files/a/b.txt");
+  EXPECT_TRUE(res.matched);
+  EXPECT_EQ(res.id, 3);
+  EXPECT_EQ(res.params, (params_type{{"path", "a/b.txt"}}));
+
+  res = router("/en/about");
+  EXPECT_TRUE(res.matched);
+  EXPECT_EQ(res.id, 4);
+  EXPECT_EQ(res.params, (params_type{{"lang", "en"}}));
+
+  res = router("/posts/1");
+  EXPECT_FALSE(res.matched);
+  EXPECT_TRUE(res.params.empty());
+}
+
+TEST(Router, FirstMatchWins)
+{
+  path_to_regex::router router{make_routes()};
+  EXPECT_EQ(router.size(), 4);
+  check_router(router);
+}
+
+TEST(Router, ParallelCompilation)
+{
+  path_to_regex::router router{make_routes(), 3};
+  EXPECT_EQ(router.size(), 4);
+  check_router(router);
+}
+
+TEST(Router, Add)
+{
+  path_to_regex::router router;
+  for (const auto& r : make_routes())
+    router.add(r);
+  check_router(router);
+}
+
+TEST(Router, InvalidPattern)
+{
+  EXPECT_THROW(path_to_regex::router({{"/:foo(\\d{3)"}}, 2), std::regex_error);
+}
+
+TEST(Router, LiteralRoutes)
+{
+  path_to_regex::router router{{{"/café", 1}, {"/a.b/", 2}, {"C:\\foo", 3}, {"", 4}}};
+
+  EXPECT_EQ(router("/café").id, 1);
+  EXPECT_EQ(router("/caf%C3%A9/").id, 1);
+  EXPECT_EQ(router("/a.b").id, 2);
+  EXPECT_FALSE(router("/axb").matched);
+  EXPECT_EQ(router("C:\\foo\\").id, 3);
+  EXPECT_EQ(router("/").id, 4);
+  EXPECT_FALSE(router("/foo").matched);
+}
+
+TEST(RouteProfile, WriteAndParse)
+{
+  path_to_regex::route_profile profile;
+  profile.add(3, 10);
+  profile.add(1);
+
+  path_to_regex::route_profile other;
+  other.add(3, 5);
+  profile.merge(other);
+
+  std::ostringstream out;
+  profile.write(out);
+  EXPECT_EQ(out.str(), "1 1\n3 15\n");
+
+  auto parsed = path_to_regex::route_profile::parse("# hits\n1 1\n\n3\t15\r\n");
+  EXPECT_EQ(parsed.hits(1), 1);
+  EXPECT_EQ(parsed.hits(3), 15);
+  EXPECT_EQ(parsed.hits(2), 0);
+
+  EXPECT_THROW(path_to_regex::route_profile::parse("1 1\n2\n"), std::invalid_argument);
+  EXPECT_THROW(path_to_regex::route_profile::parse("1 x\n"), std::invalid_argument);
+}
+
+TEST(Router, OptimizePreservesFirstMatch)
+{
+  std::vector<path_to_regex::route> routes{
+    {"/users/new", 1}, {"/users/:id", 2},   {"/:section/:id", 3}, {"/posts/:id", 4},
+    {"/static/*path", 5}, {"/USERS/me", 6, path_to_regex::case_sensitivity::case_insensitive},
+    {"{/:lang}/home", 7}, {"/posts/latest", 8},
+  };
+  path_to_regex::router reference{routes};
+  path_to_regex::router optimized{routes};
+
+  const std::vector<std::string> paths{
+    "/users/new", "/users/42", "/users/me", "/posts/1", "/posts/latest", "/static/a/b",
+    "/home", "/en/home", "/x/y", "/nothing/here/at/all", "/", "/USERS/ME",
+  };
+
+  path_to_regex::route_profile profile;
+  for (size_t i = 0; i < 100; ++i) {
+    optimized("/posts/latest", profile);
+    optimized("/users/me", profile);
+    optimized("/static/x", profile);
+  }
+  optimized("/users/42", profile);
+  EXPECT_EQ(profile.hits(2), 101);
+  EXPECT_EQ(profile.hits(3), 200);
+
+  for (auto share : {0.5, 0.9, 1.0}) {
+    optimized.optimize(profile, share);
+    for (const auto& path : paths) {
+      auto expected = reference(path);
+      auto actual = optimized(path);
+      EXPECT_EQ(actual.matched, expected.matched) << path;
+      EXPECT_EQ(actual.id, expected.id) << path;
+      EXPECT_EQ(actual.params, expected.params) << path;
+    }
+  }
+
+  optimized.add({"/late", 9});
+  EXPECT_EQ(optimized("/late").id, 9);
+}
+
+TEST(Router, Corpus)
+{
+  for (const auto& test : corpus::load_all()) {
+    SCOPED_TRACE("Pattern: " + test.pattern + ", path: " + test.path);
+    path_to_regex::router router{{{test.pattern, 1, test.sensitivity}}};
+    auto res = router(test.path);
+    EXPECT_EQ(res.matched, test.matched);
+    EXPECT_EQ(res.params, test.params);
+  }
+}
+
+} // namespace
@@ -0,0 +1,93 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <path_to_regex.hpp>
+
+namespace {
+
+using params_type = std::unordered_map<std::string, std::string>;
+
+TEST(Search, FindsAllOccurrences)
+{
+  auto matcher = path_to_regex::match("/users/:id");
+  auto results = matcher.search(R"(GET /users/42 HTTP/1.1 ref="https://example.com/users/7/" /users/x/y)");
+
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_EQ(results[0].position, 4);
+  EXPECT_EQ(results[0].length, 9);
+  EXPECT_EQ(results[0].params, (params_type{{"id", "42"}}));
+  EXPECT_EQ(results[1].position, 47);
+  EXPECT_EQ(results[1].length, 9);
+  EXPECT_EQ(results[1].params, (params_type{{"id", "7"}}));
+}
+
+TEST(Search, StopsAtQueryAndFragment)
+{
+  auto matcher = path_to_regex::match("/download/:file{.:ext}");
+  auto results = matcher.search("/download/archive.zip?token=1 /download/notes#top");
+
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_EQ(results[0].position, 0);
+  EXPECT_EQ(results[0].params, (params_type{{"file", "archive"}, {"ext", "zip"}}));
+  EXPECT_EQ(results[1].position, 30);
+  EXPECT_EQ(results[1].params, (params_type{{"file", "notes"}, {"ext", ""}}));
+}
+
+TEST(Search, RetriesLaterCandidatesInWord)
+{
+  auto matcher = path_to_regex::match("/api/:version");
+  auto results = matcher.search("/api/v1/api/v2");
+
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(results[0].position, 7);
+  EXPECT_EQ(results[0].params, (params_type{{"version", "v2"}}));
+}
+
+TEST(Search, PatternWithoutLeadingLiteral)
+{
+  auto matcher = path_to_regex::match("{/:foo}/:bar");
+  auto results = matcher.search("x /a/b c");
+
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(results[0].position, 2);
+  EXPECT_EQ(results[0].length, 4);
+  EXPECT_EQ(results[0].params, (params_type{{"foo", "a"}, {"bar", "b"}}));
+}
+
+TEST(Search, PercentEncodedAndCaseInsensitive)
+{
+  auto encoded = path_to_regex::match("/café/:id");
+  auto results = encoded.search("/caf%C3%A9/1 /café/2");
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_EQ(results[0].params, (params_type{{"id", "1"}}));
+  EXPECT_EQ(results[1].params, (params_type{{"id", "2"}}));
+
+  auto insensitive = path_to_regex::match("/foo/:id", path_to_regex::case_sensitivity::case_insensitive);
+  results = insensitive.search("/FOO/1 /Foo/2 /bar/3");
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_EQ(results[1].position, 7);
+}
+
+TEST(Search, NoMatches)
+{
+  auto matcher = path_to_regex::match("/foo");
+  EXPECT_TRUE(matcher.search("").empty());
+  EXPECT_TRUE(matcher.search("/bar /foobar").empty());
+}
+
+} // namespace
@@ -0,0 +1,93 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <regex>
+
+#include <gtest/gtest.h>
+#include <path_to_regex/snapshots.hpp>
+
+namespace {
+
+TEST(Snapshots, PublishAndRollback)
+{
+  path_to_regex::route_snapshots snapshots{2};
+  EXPECT_EQ(snapshots.current(), nullptr);
+  EXPECT_FALSE(snapshots.rollback());
+
+  EXPECT_EQ(snapshots.publish({{"/users/:id", 1}}), 1);
+  EXPECT_EQ(snapshots.publish({{"/users/me", 2}, {"/users/:id", 1}}), 2);
+  EXPECT_EQ(snapshots.current_version(), 2);
+  EXPECT_EQ((*snapshots.current())("/users/me").id, 2);
+
+  auto held = snapshots.current();
+  EXPECT_TRUE(snapshots.rollback());
+  EXPECT_EQ(snapshots.current_version(), 1);
+  EXPECT_EQ((*snapshots.current())("/users/me").id, 1);
+  EXPECT_EQ((*held)("/users/me").id, 2);
+  EXPECT_FALSE(snapshots.rollback());
+
+  snapshots.rollback(2);
+  EXPECT_EQ((*snapshots.current())("/users/me").id, 2);
+
+  EXPECT_EQ(snapshots.publish({{"/about", 3}}), 3);
+  EXPECT_EQ(snapshots.versions(), (std::vector<size_t>{2, 3}));
+  EXPECT_THROW(snapshots.rollback(1), std::out_of_range);
+  EXPECT_THROW(snapshots.get(1), std::out_of_range);
+}
+
+TEST(Snapshots, SharesUnchangedRoutes)
+{
+  path_to_regex::route_snapshots snapshots;
+  snapshots.publish({{"/users/:id", 1}, {"/files/*path", 2}});
+  snapshots.publish({{"/users/:id", 1}, {"/files/*path", 2}, {"/about", 3}});
+
+  auto v1 = snapshots.get(1);
+  auto v2 = snapshots.get(2);
+  EXPECT_EQ(v1->size(), 2);
+  EXPECT_EQ(v2->size(), 3);
+  EXPECT_EQ((*v2)("/files/a/b").id, 2);
+  EXPECT_EQ((*v2)("/about").id, 3);
+
+  EXPECT_THROW(snapshots.publish({{"/:id(\\d{3)", 4}}), std::regex_error);
+  EXPECT_EQ(snapshots.current_version(), 2);
+}
+
+TEST(Snapshots, Diff)
+{
+  path_to_regex::route_snapshots snapshots;
+  snapshots.publish({{"/users/:id", 1}, {"/about", 2}, {"/files/*path", 3}});
+  snapshots.publish({{"/users/:id", 1}, {"/about", 4}, {"/files/*path", 3}, {"/contact", 5}});
+  snapshots.publish({{"/files/*path", 3}, {"/users/:id", 1}, {"/about", 4}, {"/contact", 5}});
+
+  auto diff = snapshots.diff(1, 2);
+  ASSERT_EQ(diff.added.size(), 2);
+  EXPECT_EQ(diff.added[0].pattern, "/about");
+  EXPECT_EQ(diff.added[0].id, 4);
+  EXPECT_EQ(diff.added[1].pattern, "/contact");
+  ASSERT_EQ(diff.removed.size(), 1);
+  EXPECT_EQ(diff.removed[0].id, 2);
+  EXPECT_FALSE(diff.reordered);
+
+  diff = snapshots.diff(2, 3);
+  EXPECT_TRUE(diff.added.empty());
+  EXPECT_TRUE(diff.removed.empty());
+  EXPECT_TRUE(diff.reordered);
+
+  EXPECT_TRUE(snapshots.diff(3, 3).empty());
+}
+
+} // namespace
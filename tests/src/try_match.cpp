@@ -0,0 +1,107 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <path_to_regex.hpp>
+
+#include "corpus.hpp"
+
+namespace {
+
+using params_type = std::unordered_map<std::string, std::string>;
+
+TEST(TryMatch, Compiles)
+{
+  auto res = path_to_regex::try_match("/users/:id(\\d+)");
+  ASSERT_TRUE(res);
+  EXPECT_EQ(res.status, path_to_regex::match_status::ok);
+  ASSERT_TRUE(res.matcher);
+
+  path_to_regex::matcher::result match;
+  EXPECT_EQ(res.matcher->try_match("/users/42", match), path_to_regex::match_status::ok);
+  EXPECT_TRUE(match.matched);
+  EXPECT_EQ(match.params, (params_type{{"id", "42"}}));
+
+  EXPECT_EQ(res.matcher->try_match("/users/x", match), path_to_regex::match_status::ok);
+  EXPECT_FALSE(match.matched);
+  EXPECT_TRUE(match.params.empty());
+}
+
+TEST(TryMatch, ReportsInvalidSubpatternPosition)
+{
+  auto res = path_to_regex::try_match("/users/:id(\\d+)/:slug(\\d{3)");
+  EXPECT_FALSE(res);
+  EXPECT_EQ(res.status, path_to_regex::match_status::invalid_pattern);
+  EXPECT_EQ(res.position, 21);
+  EXPECT_FALSE(res.matcher);
+
+  res = path_to_regex::try_match("/files{/:name([a-)}", path_to_regex::case_sensitivity::case_insensitive);
+  EXPECT_EQ(res.status, path_to_regex::match_status::invalid_pattern);
+  EXPECT_EQ(res.position, 13);
+
+  // Characters of the pattern and the subpattern are percent-encoded before compiling.
+  res = path_to_regex::try_match("/my files/:id(\xC3\xA9{3)");
+  EXPECT_EQ(res.status, path_to_regex::match_status::invalid_pattern);
+  EXPECT_EQ(res.position, 13);
+
+  // The same text appears earlier as literal characters.
+  res = path_to_regex::try_match("/x(\\d{3)/:id(\\d{3)");
+  EXPECT_EQ(res.status, path_to_regex::match_status::invalid_pattern);
+  EXPECT_EQ(res.position, 12);
+}
+
+TEST(TryMatch, FindsInvalidSubpatterns)
+{
+  EXPECT_EQ(path_to_regex::find_invalid_subpattern("/users/:id(\\d+)/:slug(\\d{3)"), 21);
+  EXPECT_EQ(path_to_regex::find_invalid_subpattern("/my files/:id(\xC3\xA9{3)"), 13);
+  EXPECT_EQ(path_to_regex::find_invalid_subpattern("/users/:id(\\d+)"), std::nullopt);
+  EXPECT_EQ(path_to_regex::find_invalid_subpattern("/x(\\d{3)/:id"), std::nullopt);
+}
+
+TEST(TryMatch, SameResultsAsThrowingApi)
+{
+  const char* patterns[] = {"/users/:id", "/download/:file{.:ext}", "/files/*path", "/:lang(en|fr)/about"};
+  const char* paths[] = {"/users/42", "/download/a.zip", "/download/a", "/files/a/b", "/en/about", "/de/about"};
+
+  for (const auto* pattern : patterns) {
+    auto expected = path_to_regex::match(pattern);
+    auto actual = path_to_regex::try_match(pattern);
+    ASSERT_TRUE(actual);
+    for (const auto* path : paths) {
+      path_to_regex::matcher::result res;
+      EXPECT_EQ(actual.matcher->try_match(path, res), path_to_regex::match_status::ok);
+      auto lhs = expected(path);
+      EXPECT_EQ(lhs.matched, res.matched) << pattern << " " << path;
+      EXPECT_EQ(lhs.params, res.params) << pattern << " " << path;
+    }
+  }
+}
+
+TEST(TryMatch, Corpus)
+{
+  for (const auto& test : corpus::load_all()) {
+    SCOPED_TRACE("Pattern: " + test.pattern + ", path: " + test.path);
+    auto compiled = path_to_regex::try_match(test.pattern, test.sensitivity);
+    ASSERT_TRUE(compiled);
+    path_to_regex::matcher::result res;
+    ASSERT_EQ(compiled.matcher->try_match(test.path, res), path_to_regex::match_status::ok);
+    EXPECT_EQ(res.matched, test.matched);
+    EXPECT_EQ(res.params, test.params);
+  }
+}
+
+} // namespace
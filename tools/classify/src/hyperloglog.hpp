@@ -0,0 +1,94 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_CLASSIFY_HYPERLOGLOG_H
+#define PATH_TO_REGEX_CLASSIFY_HYPERLOGLOG_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+/**
+ * @class hyperloglog
+ * @brief HyperLogLog sketch estimating the number of distinct values of a stream.
+ *
+ * Uses 2^12 one-byte registers, which gives a standard error of about 1.6%
+ * in 4 KiB regardless of the number of values added.
+ */
+class hyperloglog {
+public:
+  void add(std::string_view value)
+  {
+    auto hash = mix(std::hash<std::string_view>{}(value));
+    auto index = hash >> (64 - precision);
+    auto rest = (hash << precision) | (uint64_t{1} << (precision - 1));
+    auto rank = static_cast<uint8_t>(count_leading_zeros(rest) + 1);
+    m_registers[index] = std::max(m_registers[index], rank);
+  }
+
+  void merge(const hyperloglog& other)
+  {
+    for (size_t i = 0; i < m_registers.size(); ++i)
+      m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+  }
+
+  double estimate() const
+  {
+    constexpr double m = register_count;
+    constexpr double alpha = 0.7213 / (1.0 + 1.079 / m);
+
+    double sum = 0;
+    size_t zeros = 0;
+    for (auto reg : m_registers) {
+      sum += std::ldexp(1.0, -reg);
+      if (reg == 0) ++zeros;
+    }
+
+    auto estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && zeros != 0) estimate = m * std::log(m / zeros);
+    return estimate;
+  }
+
+private:
+  static constexpr unsigned precision = 12;
+  static constexpr size_t register_count = size_t{1} << precision;
+
+  static uint64_t mix(uint64_t x)
+  {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+  }
+
+  static unsigned count_leading_zeros(uint64_t x)
+  {
+    unsigned n = 0;
+    for (auto bit = uint64_t{1} << 63; (x & bit) == 0; bit >>= 1)
+      ++n;
+    return n;
+  }
+
+  std::array<uint8_t, register_count> m_registers{};
+};
+
+#endif // PATH_TO_REGEX_CLASSIFY_HYPERLOGLOG_H
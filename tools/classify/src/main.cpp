@@ -0,0 +1,396 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <path_to_regex/route_file.hpp>
+
+#include "hyperloglog.hpp"
+#include "space_saving.hpp"
+
+namespace {
+
+constexpr size_t default_chunk_size = 16 << 20;
+constexpr size_t counters_per_top_value = 8;
+
+struct options {
+  std::string routes_file;
+  std::vector<std::string> log_files;
+  size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  size_t chunk_size = default_chunk_size;
+  size_t top_k = 0;
+  bool annotate = false;
+  std::string profile_file;
+};
+
+class mapped_file {
+public:
+  explicit mapped_file(const std::string& path)
+  {
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error{"cannot open '" + path + "': " + std::strerror(errno)};
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      throw std::runtime_error{"cannot stat '" + path + "': " + std::strerror(errno)};
+    }
+
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size != 0) {
+      m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (m_data == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error{"cannot map '" + path + "': " + std::strerror(errno)};
+      }
+      ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+    }
+
+    ::close(fd);
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  ~mapped_file()
+  {
+    if (m_data != nullptr && m_data != MAP_FAILED) ::munmap(m_data, m_size);
+  }
+
+  std::string_view data() const
+  {
+    return {static_cast<const char*>(m_data), m_size};
+  }
+
+private:
+  void* m_data = nullptr;
+  size_t m_size = 0;
+};
+
+struct route_table {
+  std::unique_ptr<mapped_file> file;
+  std::vector<std::string_view> patterns;
+  std::vector<size_t> ids;
+  path_to_regex::router router;
+};
+
+struct chunk {
+  std::string_view data;
+};
+
+struct param_stats {
+  std::string key;
+  space_saving top;
+  hyperloglog distinct;
+};
+
+// Statistics collected by one worker thread and merged into the first one at the end.
+struct worker_stats {
+  std::vector<uint64_t> counts;
+  std::vector<std::vector<param_stats>> params;
+
+  explicit worker_stats(size_t routes_count)
+    : counts(routes_count + 1)
+    , params(routes_count)
+  {}
+
+  param_stats& param(size_t route, const std::string& key, size_t top_k)
+  {
+    auto& route_params = params[route];
+    auto it = std::find_if(route_params.begin(), route_params.end(), [&](const auto& p) { return p.key == key; });
+    if (it != route_params.end()) return *it;
+    return route_params.emplace_back(param_stats{key, space_saving{top_k * counters_per_top_value}, {}});
+  }
+
+  void merge(const worker_stats& other, size_t top_k)
+  {
+    std::transform(counts.begin(), counts.end(), other.counts.begin(), counts.begin(), std::plus<>{});
+    for (size_t route = 0; route < params.size(); ++route) {
+      for (const auto& other_param : other.params[route]) {
+        auto& p = param(route, other_param.key, top_k);
+        p.top.merge(other_param.top);
+        p.distinct.merge(other_param.distinct);
+      }
+    }
+  }
+};
+
+void print_usage(const char* program)
+{
+  std::cerr << "Usage: " << program << " [-j THREADS] [-c CHUNK_MB] [-t TOP_K] [-p PROFILE] [-a] ROUTES LOG...\n"
+            << "\n"
+            << "Classifies the request path of every log line against the routes in ROUTES\n"
+            << "(a route file, see path_to_regex::parse_route_file) and prints per-route counts.\n"
+            << "\n"
+            << "  -j THREADS   number of worker threads (default: hardware concurrency)\n"
+            << "  -c CHUNK_MB  size of the chunks the logs are split into (default: 16)\n"
+            << "  -t TOP_K     print the TOP_K most frequent values and the approximate number\n"
+            << "               of distinct values of every route param\n"
+            << "  -p PROFILE   write the hits of every route id to PROFILE, which can be\n"
+            << "               passed to path_to_regex::router::optimize\n"
+            << "  -a           print every line prefixed with the matched route\n";
+}
+
+bool parse_options(int argc, char** argv, options& opts)
+{
+  std::vector<std::string> positional;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if ((arg == "-j" || arg == "-c" || arg == "-t") && i + 1 < argc) {
+      auto value = std::strtoul(argv[++i], nullptr, 10);
+      if (value == 0) return false;
+      if (arg == "-j")
+        opts.threads = value;
+      else if (arg == "-c")
+        opts.chunk_size = value << 20;
+      else
+        opts.top_k = value;
+    } else if (arg == "-p" && i + 1 < argc) {
+      opts.profile_file = argv[++i];
+    } else if (arg == "-a") {
+      opts.annotate = true;
+    } else if (!arg.empty() && arg.front() == '-') {
+      return false;
+    } else {
+      positional.emplace_back(arg);
+    }
+  }
+
+  if (positional.size() < 2) return false;
+
+  opts.routes_file = std::move(positional.front());
+  opts.log_files.assign(std::make_move_iterator(positional.begin() + 1), std::make_move_iterator(positional.end()));
+  return true;
+}
+
+route_table load_routes(const std::string& path, size_t threads)
+{
+  route_table table;
+  table.file = std::make_unique<mapped_file>(path);
+
+  auto file = path_to_regex::parse_route_file(table.file->data());
+  if (!file.ok()) {
+    std::string message = "invalid route file";
+    for (const auto& error : file.errors) {
+      message += "\n" + path + ":" + std::to_string(error.line) + ":" + std::to_string(error.column);
+      message += ": " + error.message;
+    }
+    throw std::runtime_error{message};
+  }
+
+  for (size_t i = 0; i < file.routes.size(); ++i) {
+    table.patterns.push_back(file.routes[i].pattern);
+    table.ids.push_back(file.routes[i].id);
+    file.routes[i].id = i;
+  }
+  table.router = path_to_regex::router{file.routes, threads};
+  return table;
+}
+
+// Splits the data into chunks of about `chunk_size` bytes that end right after a newline.
+void split_chunks(std::string_view data, size_t chunk_size, std::vector<chunk>& chunks)
+{
+  while (!data.empty()) {
+    auto end = std::min(chunk_size, data.size());
+    if (end < data.size()) {
+      auto newline = static_cast<const char*>(std::memchr(data.data() + end, '\n', data.size() - end));
+      end = newline ? static_cast<size_t>(newline - data.data()) + 1 : data.size();
+    }
+    chunks.push_back({data.substr(0, end)});
+    data.remove_prefix(end);
+  }
+}
+
+// Extracts the request path from a log line: the first word starting with '/', optionally quoted,
+// up to the query string or fragment. Lines consisting of a bare path are supported too.
+std::string_view extract_path(std::string_view line)
+{
+  for (size_t pos = 0; pos < line.size();) {
+    auto begin = line.find_first_not_of(" \t", pos);
+    if (begin == std::string_view::npos) break;
+    if (line[begin] == '"') ++begin;
+
+    auto end = line.find_first_of(" \t", begin);
+    if (end == std::string_view::npos) end = line.size();
+
+    if (begin < end && line[begin] == '/') {
+      auto word = line.substr(begin, end - begin);
+      return word.substr(0, word.find_first_of("?#\""));
+    }
+
+    pos = end;
+  }
+
+  return {};
+}
+
+class ordered_writer {
+public:
+  void write(size_t index, const std::string& text)
+  {
+    std::unique_lock lock{m_mutex};
+    m_cv.wait(lock, [&] { return m_next == index; });
+    std::fwrite(text.data(), 1, text.size(), stdout);
+    ++m_next;
+    m_cv.notify_all();
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  size_t m_next = 0;
+};
+
+void classify(const route_table& routes, const std::vector<chunk>& chunks, std::atomic<size_t>& next_chunk,
+              size_t top_k, worker_stats& stats, ordered_writer* writer)
+{
+  const auto unmatched = routes.patterns.size();
+  std::string annotated;
+
+  for (auto index = next_chunk++; index < chunks.size(); index = next_chunk++) {
+    auto data = chunks[index].data;
+    annotated.clear();
+
+    while (!data.empty()) {
+      auto newline = data.find('\n');
+      auto line = data.substr(0, newline);
+      data.remove_prefix(newline == std::string_view::npos ? data.size() : newline + 1);
+      if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+      auto path = extract_path(line);
+      auto matched = unmatched;
+      if (!path.empty()) {
+        auto res = routes.router(path);
+        if (res.matched) {
+          matched = res.id;
+          for (const auto& [key, value] : res.params) {
+            if (top_k == 0) break;
+            auto& p = stats.param(matched, key, top_k);
+            p.top.add(value);
+            p.distinct.add(value);
+          }
+        }
+      }
+      ++stats.counts[matched];
+
+      if (writer) {
+        annotated += matched == unmatched ? std::string_view{"-"} : routes.patterns[matched];
+        annotated += '\t';
+        annotated += line;
+        annotated += '\n';
+      }
+    }
+
+    if (writer) writer->write(index, annotated);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  options opts;
+  if (!parse_options(argc, argv, opts)) {
+    print_usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  try {
+    auto routes = load_routes(opts.routes_file, opts.threads);
+    const auto routes_count = routes.patterns.size();
+
+    std::vector<std::unique_ptr<mapped_file>> files;
+    std::vector<chunk> chunks;
+    for (const auto& path : opts.log_files) {
+      files.push_back(std::make_unique<mapped_file>(path));
+      split_chunks(files.back()->data(), opts.chunk_size, chunks);
+    }
+
+    auto threads_count = std::min(opts.threads, std::max<size_t>(1, chunks.size()));
+    std::vector<worker_stats> stats(threads_count, worker_stats{routes_count});
+    std::atomic<size_t> next_chunk{0};
+    ordered_writer writer;
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threads_count; ++i) {
+      threads.emplace_back(classify, std::cref(routes), std::cref(chunks), std::ref(next_chunk), opts.top_k,
+                           std::ref(stats[i]), opts.annotate ? &writer : nullptr);
+    }
+    for (auto& thread : threads)
+      thread.join();
+
+    auto& total = stats.front();
+    for (size_t i = 1; i < stats.size(); ++i)
+      total.merge(stats[i], opts.top_k);
+
+    auto& out = opts.annotate ? std::cerr : std::cout;
+    for (size_t i = 0; i < routes_count; ++i)
+      out << total.counts[i] << '\t' << routes.patterns[i] << '\n';
+    out << total.counts.back() << "\t-" << std::endl;
+
+    for (size_t i = 0; i < routes_count && opts.top_k != 0; ++i) {
+      for (const auto& p : total.params[i]) {
+        auto distinct = std::llround(p.distinct.estimate());
+        out << '\n' << routes.patterns[i] << '\t' << p.key << "\t~" << distinct << " distinct\n";
+        for (const auto& e : p.top.top(opts.top_k)) {
+          out << "  " << e.count << '\t' << e.value;
+          if (e.error != 0) out << "\t(+/- " << e.error << ')';
+          out << '\n';
+        }
+      }
+    }
+    out << std::flush;
+
+    if (!opts.profile_file.empty()) {
+      path_to_regex::route_profile profile;
+      for (size_t i = 0; i < routes_count; ++i)
+        profile.add(routes.ids[i], total.counts[i]);
+
+      std::ofstream file{opts.profile_file};
+      profile.write(file);
+      if (!file) throw std::runtime_error{"cannot write '" + opts.profile_file + "'"};
+    }
+  } catch (const std::exception& e) {
+    std::cerr << argv[0] << ": " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#ifndef PATH_TO_REGEX_CLASSIFY_SPACE_SAVING_H
+#define PATH_TO_REGEX_CLASSIFY_SPACE_SAVING_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @class space_saving
+ * @brief Space-Saving summary of the most frequent values of a stream.
+ *
+ * Keeps at most `capacity` counters. When a new value arrives and all counters are taken,
+ * the smallest counter is reassigned to it, and its count becomes the error of the new value.
+ * The counters are kept in a binary min-heap, so every update costs O(log capacity).
+ */
+class space_saving {
+public:
+  struct entry {
+    std::string value;
+    uint64_t count = 0; ///< Upper bound of the value frequency.
+    uint64_t error = 0; ///< Maximum overestimation of `count`.
+  };
+
+  explicit space_saving(size_t capacity)
+    : m_capacity{std::max<size_t>(1, capacity)}
+  {}
+
+  void add(std::string_view value, uint64_t count = 1, uint64_t error = 0)
+  {
+    m_lookup_key.assign(value);
+    auto it = m_index.find(m_lookup_key);
+    if (it != m_index.end()) {
+      m_heap[it->second].count += count;
+      m_heap[it->second].error += error;
+      sift_down(it->second);
+      return;
+    }
+
+    if (m_heap.size() < m_capacity) {
+      m_heap.push_back({m_lookup_key, count, error});
+      m_index.emplace(m_lookup_key, m_heap.size() - 1);
+      sift_up(m_heap.size() - 1);
+      return;
+    }
+
+    auto& min = m_heap.front();
+    m_index.erase(min.value);
+    min.error = min.count + error;
+    min.count += count;
+    min.value = m_lookup_key;
+    m_index.emplace(min.value, 0);
+    sift_down(0);
+  }
+
+  /**
+   * Merges the summary of another part of the stream, as in the mergeable summaries of
+   * Agarwal et al. A value missing from a full summary may have been counted up to its
+   * smallest count, which is added to the count and error of the value so that counts
+   * stay upper bounds. The `capacity` largest counters are kept.
+   */
+  void merge(const space_saving& other)
+  {
+    auto min_count = [](const space_saving& s) {
+      return s.m_heap.size() < s.m_capacity ? uint64_t{0} : s.m_heap.front().count;
+    };
+    auto this_min = min_count(*this);
+    auto other_min = min_count(other);
+
+    std::vector<entry> entries;
+    entries.reserve(m_heap.size() + other.m_heap.size());
+    for (auto& e : m_heap) {
+      auto it = other.m_index.find(e.value);
+      auto count = it == other.m_index.end() ? other_min : other.m_heap[it->second].count;
+      auto error = it == other.m_index.end() ? other_min : other.m_heap[it->second].error;
+      entries.push_back({std::move(e.value), e.count + count, e.error + error});
+    }
+    for (const auto& e : other.m_heap) {
+      if (m_index.find(e.value) == m_index.end()) entries.push_back({e.value, e.count + this_min, e.error + this_min});
+    }
+
+    if (entries.size() > m_capacity) {
+      std::nth_element(entries.begin(), entries.begin() + static_cast<ptrdiff_t>(m_capacity - 1), entries.end(),
+                       [](const entry& lhs, const entry& rhs) { return lhs.count > rhs.count; });
+      entries.resize(m_capacity);
+    }
+
+    m_heap = std::move(entries);
+    m_index.clear();
+    for (size_t i = 0; i < m_heap.size(); ++i)
+      m_index.emplace(m_heap[i].value, i);
+    for (auto i = m_heap.size() / 2; i-- > 0;)
+      sift_down(i);
+  }
+
+  std::vector<entry> top(size_t k) const
+  {
+    auto entries = m_heap;
+    auto n = std::min(k, entries.size());
+    std::partial_sort(entries.begin(), entries.begin() + n, entries.end(),
+                      [](const entry& lhs, const entry& rhs) { return lhs.count > rhs.count; });
+    entries.resize(n);
+    return entries;
+  }
+
+private:
+  void swap_entries(size_t lhs, size_t rhs)
+  {
+    std::swap(m_heap[lhs], m_heap[rhs]);
+    m_index[m_heap[lhs].value] = lhs;
+    m_index[m_heap[rhs].value] = rhs;
+  }
+
+  void sift_up(size_t i)
+  {
+    while (i > 0) {
+      auto parent = (i - 1) / 2;
+      if (m_heap[parent].count <= m_heap[i].count) break;
+      swap_entries(parent, i);
+      i = parent;
+    }
+  }
+
+  void sift_down(size_t i)
+  {
+    for (;;) {
+      auto smallest = i;
+      auto left = 2 * i + 1;
+      auto right = left + 1;
+      if (left < m_heap.size() && m_heap[left].count < m_heap[smallest].count) smallest = left;
+      if (right < m_heap.size() && m_heap[right].count < m_heap[smallest].count) smallest = right;
+      if (smallest == i) break;
+      swap_entries(smallest, i);
+      i = smallest;
+    }
+  }
+
+  size_t m_capacity;
+  std::vector<entry> m_heap;
+  std::unordered_map<std::string, size_t> m_index;
+  std::string m_lookup_key;
+};
+
+#endif // PATH_TO_REGEX_CLASSIFY_SPACE_SAVING_H
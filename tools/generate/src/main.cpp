@@ -0,0 +1,493 @@
+/******************************************************************************
+**
+** Copyright (C) 2025 Ivan Pinezhaninov <ivan.pinezhaninov@gmail.com>
+**
+** This file is part of the Path-to-Regex which can be found at
+** https://github.com/IvanPinezhaninov/path_to_regex/.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+** OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+** THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+******************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <path_to_regex/details/tokenizer.hpp>
+#include <path_to_regex/route_file.hpp>
+
+namespace {
+
+using path_to_regex::details::token;
+using path_to_regex::details::token_kind;
+
+// Routes with more optional groups are not specialized, since every group doubles the generated code.
+constexpr size_t max_specialized_optionals = 4;
+
+struct options {
+  std::string routes_file;
+  std::string output;
+  std::string name_space = "routes";
+  std::string function = "match";
+};
+
+struct step {
+  enum kind_type { literal, param, wildcard, optional_begin, optional_end, end } kind;
+  std::string text;
+  size_t capture = 0;
+  size_t group_end = 0;
+  std::vector<size_t> group_captures;
+};
+
+std::string quote(std::string_view str)
+{
+  std::string quoted = "\"";
+  for (unsigned char ch : str) {
+    if (ch == '"' || ch == '\\') {
+      quoted += '\\';
+      quoted += static_cast<char>(ch);
+    } else if (ch < 0x20 || ch >= 0x7F) {
+      char buf[8];
+      std::snprintf(buf, sizeof(buf), "\\%03o", ch);
+      quoted += buf;
+    } else {
+      quoted += static_cast<char>(ch);
+    }
+  }
+  return quoted + '"';
+}
+
+std::string to_lower(std::string str)
+{
+  for (auto& ch : str)
+    ch = path_to_regex::details::to_lower_ascii(ch);
+  return str;
+}
+
+std::string char_literal(char ch)
+{
+  auto quoted = quote(std::string_view{&ch, 1});
+  if (quoted == "\"'\"") return "'\\''";
+  return "'" + quoted.substr(1, quoted.size() - 2) + "'";
+}
+
+class route_generator {
+public:
+  route_generator(const path_to_regex::route& r, size_t index)
+    : m_index{index}
+    , m_sensitivity{r.sensitivity}
+    , m_pattern{r.pattern}
+  {
+    auto encoded = path_to_regex::details::percent_encode(r.pattern);
+    m_separator = path_to_regex::details::find_separator(r.pattern);
+
+    auto tokens = path_to_regex::details::tokenize(encoded);
+    if (!tokens.empty() && tokens.front().kind == token_kind::literal) {
+      m_prefix = tokens.front().value;
+      if (tokens.size() == 1 && m_prefix.back() == m_separator) m_prefix.pop_back();
+    }
+
+    m_specialized = flatten(tokens);
+    if (m_specialized) {
+      strip_trailing_separator();
+      m_steps.push_back({step::end, {}, 0, 0, {}});
+    }
+  }
+
+  // Folded literal every matching path starts with; the dispatcher branches on it.
+  std::string prefix() const
+  {
+    return to_lower(m_prefix);
+  }
+
+  void write(std::ostream& out)
+  {
+    out << "// " << quote(m_pattern) << "\n";
+    // Specialized routes without params leave the result unnamed, so the output builds without warnings.
+    auto res = m_specialized && m_keys.empty() ? "" : " res";
+    out << "bool route_" << m_index << "(std::string_view path, path_to_regex::router::result&" << res << ")\n{\n";
+
+    if (!m_specialized) {
+      out << "  static const auto matcher = path_to_regex::match(" << quote(m_pattern) << ", "
+          << sensitivity_name() << ");\n"
+          << "  auto match = matcher(path);\n"
+          << "  if (!match.matched) return false;\n"
+          << "  res.params = std::move(match.params);\n"
+          << "  return true;\n}\n\n";
+      return;
+    }
+
+    out << "  const char* s = path.data();\n"
+        << "  const size_t n = path.size();\n";
+    if (!m_keys.empty()) out << "  std::string_view caps[" << m_keys.size() << "];\n";
+    emit(out, 0, "0", 1);
+    out << "  return false;\n}\n\n";
+  }
+
+private:
+  bool flatten(const std::vector<token>& tokens)
+  {
+    for (const auto& t : tokens) {
+      switch (t.kind) {
+      case token_kind::literal:
+        m_steps.push_back({step::literal, t.value, 0, 0, {}});
+        break;
+      case token_kind::param:
+      case token_kind::wildcard:
+        m_steps.push_back({t.kind == token_kind::param ? step::param : step::wildcard, {}, m_keys.size(), 0, {}});
+        m_keys.push_back(path_to_regex::details::percent_decode(t.value));
+        break;
+      case token_kind::custom_param:
+        return false;
+      case token_kind::optional: {
+        if (++m_optionals > max_specialized_optionals) return false;
+        auto begin = m_steps.size();
+        auto first_capture = m_keys.size();
+        m_steps.push_back({step::optional_begin, {}, 0, 0, {}});
+        if (!flatten(t.tokens)) return false;
+        m_steps.push_back({step::optional_end, {}, 0, 0, {}});
+        m_steps[begin].group_end = m_steps.size();
+        for (auto i = first_capture; i < m_keys.size(); ++i)
+          m_steps[begin].group_captures.push_back(i);
+        break;
+      }
+      }
+    }
+    return true;
+  }
+
+  // `make_pattern` makes a trailing separator optional; the end step accepts an optional separator anyway.
+  void strip_trailing_separator()
+  {
+    if (m_steps.empty() || m_steps.back().kind != step::literal) return;
+    auto& text = m_steps.back().text;
+    if (text.back() != m_separator) return;
+    text.pop_back();
+    if (text.empty()) m_steps.pop_back();
+  }
+
+  std::string sensitivity_name() const
+  {
+    return m_sensitivity == path_to_regex::case_sensitivity::case_sensitive
+             ? "path_to_regex::case_sensitivity::case_sensitive"
+             : "path_to_regex::case_sensitivity::case_insensitive";
+  }
+
+  bool insensitive() const
+  {
+    return m_sensitivity == path_to_regex::case_sensitivity::case_insensitive;
+  }
+
+  // Returns true if a param followed by step `i` can only end at the next separator.
+  bool ends_at_separator(size_t i) const
+  {
+    while (m_steps[i].kind == step::optional_end)
+      ++i;
+    if (m_steps[i].kind == step::end) return true;
+    return m_steps[i].kind == step::literal && m_steps[i].text.front() == m_separator;
+  }
+
+  // Emits the code matching steps `i...` at position `pos`. Every successful path through the code returns true.
+  void emit(std::ostream& out, size_t i, const std::string& pos, size_t depth)
+  {
+    std::string indent(depth * 2, ' ');
+    auto var = "p" + std::to_string(m_vars++);
+    const auto& st = m_steps[i];
+
+    switch (st.kind) {
+    case step::literal: {
+      auto len = std::to_string(st.text.size());
+      out << indent << "if (n - " << pos << " >= " << len << " && "
+          << (insensitive() ? "equal_folded(s + " + pos + ", " + quote(to_lower(st.text)) + ", " + len + ")"
+                            : "std::memcmp(s + " + pos + ", " + quote(st.text) + ", " + len + ") == 0")
+          << ") {\n";
+      out << indent << "  const size_t " << var << " = " << pos << " + " << len << ";\n";
+      emit(out, i + 1, var, depth + 1);
+      out << indent << "}\n";
+      break;
+    }
+    case step::param: {
+      auto limit = var + "_limit";
+      out << indent << "size_t " << limit << " = " << pos << ";\n";
+      out << indent << "while (" << limit << " < n && s[" << limit << "] != " << char_literal(m_separator) << ") ++"
+          << limit << ";\n";
+      if (ends_at_separator(i + 1)) {
+        out << indent << "if (" << limit << " > " << pos << ") {\n";
+        out << indent << "  const size_t " << var << " = " << limit << ";\n";
+      } else {
+        out << indent << "for (size_t " << var << " = " << pos << " + 1; " << var << " <= " << limit << "; ++" << var
+            << ") {\n";
+      }
+      out << indent << "  caps[" << st.capture << "] = {s + " << pos << ", " << var << " - " << pos << "};\n";
+      emit(out, i + 1, var, depth + 1);
+      out << indent << "}\n";
+      break;
+    }
+    case step::wildcard:
+      out << indent << "for (size_t " << var << " = " << pos << " + 1; " << var << " <= n; ++" << var << ") {\n";
+      out << indent << "  caps[" << st.capture << "] = {s + " << pos << ", " << var << " - " << pos << "};\n";
+      emit(out, i + 1, var, depth + 1);
+      out << indent << "}\n";
+      break;
+    case step::optional_begin:
+      out << indent << "{\n";
+      emit(out, i + 1, pos, depth + 1);
+      out << indent << "}\n";
+      for (auto capture : st.group_captures)
+        out << indent << "caps[" << capture << "] = {};\n";
+      emit(out, st.group_end, pos, depth);
+      break;
+    case step::optional_end:
+      emit(out, i + 1, pos, depth);
+      break;
+    case step::end:
+      out << indent << "if (" << pos << " == n || (" << pos << " + 1 == n && s[" << pos
+          << "] == " << char_literal(m_separator) << ")) {\n";
+      for (size_t k = 0; k < m_keys.size(); ++k)
+        out << indent << "  res.params[" << quote(m_keys[k]) << "] = path_to_regex::details::percent_decode(caps[" << k
+            << "]);\n";
+      out << indent << "  return true;\n";
+      out << indent << "}\n";
+      break;
+    }
+  }
+
+  size_t m_index;
+  path_to_regex::case_sensitivity m_sensitivity;
+  std::string m_pattern;
+  char m_separator = '/';
+  bool m_specialized = false;
+  size_t m_optionals = 0;
+  size_t m_vars = 0;
+  std::vector<step> m_steps;
+  std::vector<std::string> m_keys;
+  std::string m_prefix;
+};
+
+// Trie of the folded literal prefixes of the routes.
+struct trie_node {
+  std::map<char, trie_node> children;
+  std::vector<size_t> routes;
+};
+
+class dispatcher_generator {
+public:
+  dispatcher_generator(const std::vector<std::string>& prefixes, const std::vector<size_t>& ids)
+    : m_ids{ids}
+  {
+    for (size_t i = 0; i < prefixes.size(); ++i) {
+      auto* node = &m_root;
+      for (auto ch : prefixes[i])
+        node = &node->children[ch];
+      node->routes.push_back(i);
+    }
+  }
+
+  void write(std::ostream& out)
+  {
+    emit(out, m_root, 0, {}, 1);
+  }
+
+private:
+  void emit_tries(std::ostream& out, const std::vector<size_t>& routes, const std::string& indent)
+  {
+    for (auto route : routes) {
+      out << indent << "if (route_" << route << "(path, res)) {\n"
+          << indent << "  res.matched = true;\n"
+          << indent << "  res.id = " << m_ids[route] << ";\n"
+          << indent << "  return res;\n"
+          << indent << "}\n";
+    }
+    out << indent << "return res;\n";
+  }
+
+  // Emits the dispatch of the paths starting with the prefix of `node`. Every route whose prefix is
+  // a prefix of the path is tried in route order, and the generated code always returns.
+  void emit(std::ostream& out, const trie_node& node, size_t depth, std::vector<size_t> candidates, size_t level)
+  {
+    std::string indent(level * 2, ' ');
+    candidates.insert(candidates.end(), node.routes.begin(), node.routes.end());
+    std::sort(candidates.begin(), candidates.end());
+
+    if (node.children.size() == 1) {
+      std::string chain;
+      const auto* child = &node;
+      do {
+        chain += child->children.begin()->first;
+        child = &child->children.begin()->second;
+      } while (child->children.size() == 1 && child->routes.empty());
+
+      out << indent << "if (n >= " << depth + chain.size() << " && equal_folded(s + " << depth << ", "
+          << quote(chain) << ", " << chain.size() << ")) {\n";
+      emit(out, *child, depth + chain.size(), candidates, level + 1);
+      out << indent << "}\n";
+    } else if (!node.children.empty()) {
+      out << indent << "if (n > " << depth << ") {\n";
+      out << indent << "  switch (path_to_regex::details::to_lower_ascii(s[" << depth << "])) {\n";
+      for (const auto& [ch, child] : node.children) {
+        out << indent << "  case " << char_literal(ch) << ": {\n";
+        emit(out, child, depth + 1, candidates, level + 2);
+        out << indent << "  }\n";
+      }
+      out << indent << "  }\n";
+      out << indent << "}\n";
+    }
+
+    emit_tries(out, candidates, indent);
+  }
+
+  trie_node m_root;
+  const std::vector<size_t>& m_ids;
+};
+
+void print_usage(const char* program)
+{
+  std::cerr << "Usage: " << program << " [-n NAMESPACE] [-f FUNCTION] ROUTES OUTPUT\n"
+            << "\n"
+            << "Generates OUTPUT.hpp and OUTPUT.cpp with a function matching paths against\n"
+            << "the routes of the route file ROUTES, equivalent to path_to_regex::router.\n"
+            << "\n"
+            << "  -n NAMESPACE  namespace of the generated function (default: routes)\n"
+            << "  -f FUNCTION   name of the generated function (default: match)\n";
+}
+
+bool parse_options(int argc, char** argv, options& opts)
+{
+  std::vector<std::string> positional;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (arg == "-n" && i + 1 < argc)
+      opts.name_space = argv[++i];
+    else if (arg == "-f" && i + 1 < argc)
+      opts.function = argv[++i];
+    else if (!arg.empty() && arg.front() == '-')
+      return false;
+    else
+      positional.emplace_back(arg);
+  }
+
+  if (positional.size() != 2) return false;
+
+  opts.routes_file = std::move(positional[0]);
+  opts.output = std::move(positional[1]);
+  return true;
+}
+
+std::string read_file(const std::string& path)
+{
+  std::ifstream file{path, std::ios::binary};
+  if (!file) throw std::runtime_error{"cannot open '" + path + "'"};
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+void write_file(const std::string& path, const std::string& contents)
+{
+  std::ofstream file{path, std::ios::binary};
+  file << contents;
+  if (!file) throw std::runtime_error{"cannot write '" + path + "'"};
+}
+
+std::string make_header(const options& opts)
+{
+  std::ostringstream out;
+  out << "// Generated by path_to_regex_generate. Do not edit.\n\n"
+      << "#pragma once\n\n"
+      << "#include <string_view>\n\n"
+      << "#include <path_to_regex/router.hpp>\n\n"
+      << "namespace " << opts.name_space << " {\n\n"
+      << "path_to_regex::router::result " << opts.function << "(std::string_view path);\n\n"
+      << "} // namespace " << opts.name_space << "\n";
+  return out.str();
+}
+
+std::string make_source(const options& opts, const path_to_regex::route_file& file, const std::string& header_name)
+{
+  std::ostringstream out;
+  out << "// Generated by path_to_regex_generate. Do not edit.\n\n"
+      << "#include \"" << header_name << "\"\n\n"
+      << "#include <cstring>\n"
+      << "#include <string>\n\n"
+      << "#include <path_to_regex.hpp>\n\n"
+      << "namespace {\n\n"
+      << "bool equal_folded(const char* str, const char* lower, size_t size)\n{\n"
+      << "  for (size_t i = 0; i < size; ++i)\n"
+      << "    if (path_to_regex::details::to_lower_ascii(str[i]) != lower[i]) return false;\n"
+      << "  return true;\n}\n\n"
+      << "bool needs_encoding(std::string_view path)\n{\n"
+      << "  for (unsigned char ch : path)\n"
+      << "    if (path_to_regex::details::needs_percent_encoding(ch)) return true;\n"
+      << "  return false;\n}\n\n";
+
+  std::vector<std::string> prefixes;
+  std::vector<size_t> ids;
+  for (size_t i = 0; i < file.routes.size(); ++i) {
+    route_generator route{file.routes[i], i};
+    route.write(out);
+    prefixes.push_back(route.prefix());
+    ids.push_back(file.routes[i].id);
+  }
+
+  out << "} // namespace\n\n"
+      << "namespace " << opts.name_space << " {\n\n"
+      << "path_to_regex::router::result " << opts.function << "(std::string_view path)\n{\n"
+      << "  path_to_regex::router::result res;\n"
+      << "  std::string encoded;\n"
+      << "  if (needs_encoding(path)) {\n"
+      << "    encoded = path_to_regex::details::percent_encode(path);\n"
+      << "    path = encoded;\n"
+      << "  }\n\n"
+      << "  const char* s = path.data();\n"
+      << "  const size_t n = path.size();\n"
+      << "  (void)s;\n\n";
+  dispatcher_generator{prefixes, ids}.write(out);
+  out << "}\n\n"
+      << "} // namespace " << opts.name_space << "\n";
+  return out.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  options opts;
+  if (!parse_options(argc, argv, opts)) {
+    print_usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  try {
+    auto text = read_file(opts.routes_file);
+    auto file = path_to_regex::parse_route_file(text);
+    if (!file.ok()) {
+      for (const auto& error : file.errors)
+        std::cerr << opts.routes_file << ":" << error.line << ":" << error.column << ": " << error.message << "\n";
+      return EXIT_FAILURE;
+    }
+
+    auto header_name = opts.output.substr(opts.output.find_last_of("/\\") + 1) + ".hpp";
+    write_file(opts.output + ".hpp", make_header(opts));
+    write_file(opts.output + ".cpp", make_source(opts, file, header_name));
+  } catch (const std::exception& e) {
+    std::cerr << argv[0] << ": " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}